@@ -0,0 +1,205 @@
+/*
+
+au_BatchGoertzel.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Offline Goertzel analysis of whole recordings. Walks a buffer as consecutive or hopped windows and returns a magnitude/phase
+time series (one GoertzelAlgorithm::ComplexPolarForm per window).
+
+Each window is a serial recurrence, so several windows are run side by side (WINDOW_LANES independent recurrences per loop)
+to keep the FPU busy rather than waiting on one dependency chain. Multichannel recordings are split across threads by
+channel and window range. Buffers can be any type convertible to sample_t (e.g. float, double or int), read in place.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_GoertzelAlgorithm.h"
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+class BatchGoertzel
+{
+public:
+
+    static constexpr unsigned int WINDOW_LANES = 8;
+
+    /*
+    Uses the same parameters as GoertzelAlgorithm. Hop defaults to the window length (consecutive windows).
+    */
+    void setup(const GoertzelAlgorithm::SetupParameters& setup_parameters)
+    {
+        m_goertzel.setup(setup_parameters);
+        m_hop_samples = m_goertzel.getWindowLengthSamples();
+    }
+
+    /*
+    Set the number of samples between the start of consecutive windows. 0 sets it to the window length.
+    */
+    void setHopSamples(size_t hop_samples)
+    {
+        m_hop_samples = hop_samples > 0 ? hop_samples : m_goertzel.getWindowLengthSamples();
+    }
+
+    size_t getHopSamples()
+    {
+        return m_hop_samples;
+    }
+
+    size_t getWindowLengthSamples()
+    {
+        return m_goertzel.getWindowLengthSamples();
+    }
+
+    /*
+    Number of complete windows in a buffer of num_samples, i.e. the length of the result buffer needed.
+    */
+    size_t getNumWindows(size_t num_samples)
+    {
+        size_t window_length = getWindowLengthSamples();
+        if (num_samples < window_length || window_length == 0)
+        {
+            return 0;
+        }
+        return ((num_samples - window_length) / m_hop_samples) + 1;
+    }
+
+    /*
+    Analyse a range of windows of a single channel. Can be used to spread work over an existing thread pool.
+
+    Parameters:
+    buffer - whole channel buffer
+    first_window - index of the first window to analyse (window i starts at sample i * hop)
+    num_windows - number of windows to analyse. Must not go past getNumWindows() for the buffer.
+    results - buffer of num_windows results
+    */
+    template<typename T>
+    void processWindows(const T* buffer, size_t first_window, size_t num_windows, GoertzelAlgorithm::ComplexPolarForm* results)
+    {
+        const size_t window_length = getWindowLengthSamples();
+        size_t window = 0;
+
+        for ( ; window + WINDOW_LANES <= num_windows ; window += WINDOW_LANES)
+        {
+            const T* window_starts[WINDOW_LANES];
+            GoertzelAlgorithm::QValues q_vals[WINDOW_LANES];
+            for (unsigned int lane = 0 ; lane < WINDOW_LANES ; lane++)
+            {
+                window_starts[lane] = &buffer[(first_window + window + lane) * m_hop_samples];
+            }
+            for (size_t n = 0 ; n < window_length ; n++)
+            {
+                for (unsigned int lane = 0 ; lane < WINDOW_LANES ; lane++)
+                {
+                    m_goertzel.process(static_cast<sample_t>(window_starts[lane][n]), q_vals[lane]);
+                }
+            }
+            for (unsigned int lane = 0 ; lane < WINDOW_LANES ; lane++)
+            {
+                results[window + lane] = m_goertzel.getComplexMagnitudeAndPhase(q_vals[lane]);
+            }
+        }
+
+        //Remaining windows
+        for ( ; window < num_windows ; window++)
+        {
+            const T* window_start = &buffer[(first_window + window) * m_hop_samples];
+            GoertzelAlgorithm::QValues q_vals;
+            for (size_t n = 0 ; n < window_length ; n++)
+            {
+                m_goertzel.process(static_cast<sample_t>(window_start[n]), q_vals);
+            }
+            results[window] = m_goertzel.getComplexMagnitudeAndPhase(q_vals);
+        }
+    }
+
+    /*
+    Analyse every window of a single channel on the calling thread.
+
+    Parameters:
+    results - buffer of getNumWindows(num_samples) results
+    */
+    template<typename T>
+    void processChannel(const T* buffer, size_t num_samples, GoertzelAlgorithm::ComplexPolarForm* results)
+    {
+        processWindows(buffer, 0, getNumWindows(num_samples), results);
+    }
+
+    /*
+    Analyse every window of several channels, split across threads.
+
+    Parameters:
+    buffers - one buffer per channel, each num_samples long
+    results - one result buffer per channel, each getNumWindows(num_samples) long
+    num_threads - number of threads to use, 0 uses the number of hardware threads
+    */
+    template<typename T>
+    void processChannels(const T* const* buffers, unsigned int num_channels, size_t num_samples,
+                         GoertzelAlgorithm::ComplexPolarForm* const* results, unsigned int num_threads = 0)
+    {
+        const size_t num_windows = getNumWindows(num_samples);
+        const size_t total_windows = num_windows * num_channels;
+        if (total_windows == 0)
+        {
+            return;
+        }
+
+        if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+        if (num_threads == 0)
+        {
+            num_threads = 1;
+        }
+        //Keep at least one group of lanes per thread
+        size_t max_useful_threads = (total_windows + WINDOW_LANES - 1) / WINDOW_LANES;
+        if (num_threads > max_useful_threads)
+        {
+            num_threads = static_cast<unsigned int>(max_useful_threads);
+        }
+
+        //Windows of all channels are treated as one range, split evenly between threads
+        auto process_range = [this, buffers, results, num_windows](size_t begin, size_t end)
+        {
+            while (begin < end)
+            {
+                size_t channel = begin / num_windows;
+                size_t first_window = begin % num_windows;
+                size_t windows_in_channel = num_windows - first_window;
+                size_t count = (end - begin) < windows_in_channel ? (end - begin) : windows_in_channel;
+                processWindows(buffers[channel], first_window, count, &results[channel][first_window]);
+                begin += count;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        size_t windows_per_thread = total_windows / num_threads;
+        size_t begin = 0;
+        for (unsigned int thread = 0 ; thread < num_threads ; thread++)
+        {
+            size_t end = (thread == num_threads - 1) ? total_windows : begin + windows_per_thread;
+            if (thread == num_threads - 1)
+            {
+                process_range(begin, end);
+            }
+            else
+            {
+                threads.emplace_back(process_range, begin, end);
+            }
+            begin = end;
+        }
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+    }
+
+private:
+    GoertzelAlgorithm m_goertzel;
+    size_t m_hop_samples = 1;
+};
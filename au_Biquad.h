@@ -18,11 +18,15 @@ http://www.earlevel.com/main/2012/11/25/biquad-c-source-code/
 #pragma once
 
 #include "au_config.h"
+#include "au_Denormals.h"
 #include <math.h>
+#include <stddef.h>
 
-class Biquad
+/*
+Filter types, shared by every sample type so e.g. Biquad::FilterType::LOWPASS can set up a BasicBiquad<double>.
+*/
+struct BiquadBase
 {
-public:
     enum class FilterType
     {
         LOWPASS,
@@ -33,47 +37,130 @@ public:
         LOWSHELF,
         HIGHSHELF
     };
+};
 
+/*
+Biquad filter, templated on sample type. Biquad (float) covers most uses. BasicBiquad<double> is for filters where float
+coefficients and state lose too much precision, e.g. low cutoffs relative to the sample rate.
+*/
+template<typename sample_type>
+class BasicBiquad : public BiquadBase
+{
+public:
     struct FilterSetup
     {
-        sample_t sample_rate_hz;
-        sample_t cutoff_freq_hz;
-        sample_t quality_factor;
-        sample_t filter_gain_db;
+        sample_type sample_rate_hz;
+        sample_type cutoff_freq_hz;
+        sample_type quality_factor;
+        sample_type filter_gain_db;
         FilterType filter_type;
     };
 
     struct Coefficients
     {
-        sample_t a0, a1, a2, b1, b2;
+        sample_type a0, a1, a2, b1, b2;
     };
     
 
     void setup(FilterSetup filter_setup);
 
-    void setSampleRate(sample_t sample_rate_hz);
-    void setCutoff(sample_t cutoff_freq_hz);
-    void setQ(sample_t quality_factor);
-    void setFilterGain(sample_t filter_gain_db);
+    void setSampleRate(sample_type sample_rate_hz);
+    void setCutoff(sample_type cutoff_freq_hz);
+    void setQ(sample_type quality_factor);
+    void setFilterGain(sample_type filter_gain_db);
     void setType(FilterType filter_type);
 	void setCoefficients(Coefficients biquad_coefficients);
-
-    sample_t process(sample_t input_sample);
+    Coefficients getCoefficients();
+
+    /*
+    Calculate the coefficients for a filter setup without applying them (e.g. for use with MultichannelBiquad).
+    */
+    static Coefficients designCoefficients(const FilterSetup& filter_setup);
+
+    /*
+    Approximate version of designCoefficients() for modulated filters. Replaces the libm tan() and pow() calls with a
+    rational (Pade) tan approximation and a polynomial exp2, both evaluated in double and accurate to better than float precision.
+
+    Accuracy versus designCoefficients(), for cutoffs from 10Hz to 0.49 x sample rate at 48kHz, Q from 0.1 to 20 and gain up to +/-24dB:
+    - Coefficients within 1e-6 relative to the largest coefficient of the filter (in most cases bit identical)
+    - Magnitude response within 0.002dB, excluding regions where either response is below -60dB (e.g. notch nulls).
+      For comparison, a 1 ULP change of a 20Hz cutoff changes the exact design by up to 0.05dB.
+    */
+    static Coefficients designCoefficientsFast(const FilterSetup& filter_setup);
+
+    /*
+    Calculate coefficients from the prewarped cutoff K = tan(PI * cutoff / sample rate), the linear gain V = 10^(|gain dB| / 20)
+    and sqrt(2 * V). Used by both design paths, and constexpr so it can be evaluated at compile time (see FixedBiquad).
+    filter_setup.sample_rate_hz and filter_setup.cutoff_freq_hz are not used.
+    */
+    static constexpr Coefficients designFromPrewarpedCutoff(const FilterSetup& filter_setup, sample_type K, sample_type V, sample_type sqrt_2V);
+
+    /*
+    When enabled, setters use designCoefficientsFast() rather than designCoefficients().
+    */
+    void setFastDesign(bool use_fast_design);
+
+    /*
+    Set the number of samples over which coefficients are linearly interpolated when a setter changes the filter design.
+    0 (default) applies new coefficients immediately. setup() and setCoefficients() always apply immediately.
+    Intended for ramps over roughly one block, with a new design calculated per block rather than per sample.
+    */
+    void setCoefficientRampLength(unsigned int ramp_length_samples);
+
+    /*
+    Linearly interpolate from the current coefficients to target_coefficients over ramp_length_samples.
+    The stable region of (b1, b2) is a triangle, so interpolating between two stable designs is stable at every step.
+    */
+    void rampToCoefficients(Coefficients target_coefficients, unsigned int ramp_length_samples);
+    bool isRamping();
+
+    sample_type process(sample_type input_sample);
+
+    /*
+    Process a block of samples. Filter state is held locally for the whole block rather than written back every sample.
+
+    Parameters:
+    input_buffer - samples to process
+    output_buffer - buffer to write filtered samples to. Can be the same as input_buffer for in-place processing.
+    num_samples - number of samples in the block
+    */
+    void processBlock(const sample_type* input_buffer, sample_type* output_buffer, size_t num_samples);
     void clean();
 
+    /*
+    Zero filter state that has decayed below DENORMAL_FLUSH_THRESHOLD. Call once per block to keep silent tails out of the
+    denormal range (see au_Denormals.h).
+    */
+    void flushDenormals();
+
 
 private:
 
     void calcCoefficients();
+    Coefficients designCurrentSetup();
+    void stepCoefficientRamp();
+
+
+    //tan(PI * normalised_freq) for normalised_freq in [0, 0.5)
+    static sample_type fastTanPi(sample_type normalised_freq);
+    static sample_type fastDbToLin(sample_type db_value);
 
     Coefficients m_coefficients;
-    sample_t m_z1 = 0.0;
-    sample_t m_z2 = 0.0;
-    sample_t m_sample_rate_hz, m_cutoff_freq_hz, m_quality_factor, m_filter_gain_db;
+    sample_type m_z1 = 0.0;
+    sample_type m_z2 = 0.0;
+    sample_type m_sample_rate_hz, m_cutoff_freq_hz, m_quality_factor, m_filter_gain_db;
     FilterType m_filter_type;
 
+    bool m_use_fast_design = false;
+    unsigned int m_ramp_length_samples = 0;
+    unsigned int m_ramp_samples_remaining = 0;
+    Coefficients m_target_coefficients;
+    Coefficients m_coefficient_increments;
+
 };
 
+typedef BasicBiquad<sample_t> Biquad;
+
 
 
 /*
@@ -86,7 +173,8 @@ Implementation
 
 
 
-void Biquad::setup(FilterSetup filter_setup)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setup(FilterSetup filter_setup)
 {
     m_sample_rate_hz = filter_setup.sample_rate_hz;
     m_cutoff_freq_hz = filter_setup.cutoff_freq_hz;
@@ -94,149 +182,318 @@ void Biquad::setup(FilterSetup filter_setup)
     m_filter_gain_db = filter_setup.filter_gain_db;
     m_filter_type = filter_setup.filter_type;
     clean();
-    calcCoefficients();
+    setCoefficients(designCurrentSetup());
 }
 
-void Biquad::setSampleRate(sample_t sample_rate_hz)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setSampleRate(sample_type sample_rate_hz)
 {
     m_sample_rate_hz = sample_rate_hz;
     calcCoefficients();
 }
 
-void Biquad::setCutoff(sample_t cutoff_freq_hz)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setCutoff(sample_type cutoff_freq_hz)
 {
     m_cutoff_freq_hz = cutoff_freq_hz;
     calcCoefficients();
 }
 
-void Biquad::setQ(sample_t quality_factor)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setQ(sample_type quality_factor)
 {
     m_quality_factor = quality_factor;
     calcCoefficients();
 }
 
-void Biquad::setFilterGain(sample_t filter_gain_db)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setFilterGain(sample_type filter_gain_db)
 {
     m_filter_gain_db = filter_gain_db;
     calcCoefficients();
 }
 
-void Biquad::setType(FilterType filter_type)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setType(FilterType filter_type)
 {
     m_filter_type = filter_type;
     calcCoefficients();
 }
 
-void Biquad::setCoefficients(Coefficients biquad_coefficients)
+template<typename sample_type>
+void BasicBiquad<sample_type>::setCoefficients(Coefficients biquad_coefficients)
 {
 	m_coefficients = biquad_coefficients;
+    m_ramp_samples_remaining = 0;
+}
+
+template<typename sample_type>
+typename BasicBiquad<sample_type>::Coefficients BasicBiquad<sample_type>::getCoefficients()
+{
+    return m_coefficients;
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::setFastDesign(bool use_fast_design)
+{
+    m_use_fast_design = use_fast_design;
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::setCoefficientRampLength(unsigned int ramp_length_samples)
+{
+    m_ramp_length_samples = ramp_length_samples;
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::rampToCoefficients(Coefficients target_coefficients, unsigned int ramp_length_samples)
+{
+    if (ramp_length_samples == 0)
+    {
+        setCoefficients(target_coefficients);
+        return;
+    }
+    sample_type inverse_length = 1.0 / ramp_length_samples;
+    m_target_coefficients = target_coefficients;
+    m_coefficient_increments.a0 = (target_coefficients.a0 - m_coefficients.a0) * inverse_length;
+    m_coefficient_increments.a1 = (target_coefficients.a1 - m_coefficients.a1) * inverse_length;
+    m_coefficient_increments.a2 = (target_coefficients.a2 - m_coefficients.a2) * inverse_length;
+    m_coefficient_increments.b1 = (target_coefficients.b1 - m_coefficients.b1) * inverse_length;
+    m_coefficient_increments.b2 = (target_coefficients.b2 - m_coefficients.b2) * inverse_length;
+    m_ramp_samples_remaining = ramp_length_samples;
+}
+
+template<typename sample_type>
+bool BasicBiquad<sample_type>::isRamping()
+{
+    return m_ramp_samples_remaining > 0;
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::stepCoefficientRamp()
+{
+    if (--m_ramp_samples_remaining == 0)
+    {
+        //Snap to target to avoid accumulated rounding error
+        m_coefficients = m_target_coefficients;
+        return;
+    }
+    m_coefficients.a0 += m_coefficient_increments.a0;
+    m_coefficients.a1 += m_coefficient_increments.a1;
+    m_coefficients.a2 += m_coefficient_increments.a2;
+    m_coefficients.b1 += m_coefficient_increments.b1;
+    m_coefficients.b2 += m_coefficient_increments.b2;
 }
 
-sample_t Biquad::process(sample_t input_sample)
+template<typename sample_type>
+sample_type BasicBiquad<sample_type>::process(sample_type input_sample)
 {
-    sample_t output_sample = (input_sample * m_coefficients.a0) + m_z1;
+    if (m_ramp_samples_remaining > 0)
+    {
+        stepCoefficientRamp();
+    }
+    sample_type output_sample = (input_sample * m_coefficients.a0) + m_z1;
     m_z1 = (input_sample * m_coefficients.a1) + m_z2 - (output_sample * m_coefficients.b1);
     m_z2 = (input_sample * m_coefficients.a2) - (output_sample * m_coefficients.b2);
     return output_sample;
 }
 
-void Biquad::clean()
+template<typename sample_type>
+void BasicBiquad<sample_type>::processBlock(const sample_type* input_buffer, sample_type* output_buffer, size_t num_samples)
+{
+    size_t i = 0;
+
+    //Ramping portion of the block, coefficients updated every sample
+    for ( ; i < num_samples && m_ramp_samples_remaining > 0 ; i++)
+    {
+        output_buffer[i] = process(input_buffer[i]);
+    }
+
+    const Coefficients c = m_coefficients;
+    sample_type z1 = m_z1;
+    sample_type z2 = m_z2;
+    for ( ; i < num_samples ; i++)
+    {
+        sample_type input_sample = input_buffer[i];
+        sample_type output_sample = (input_sample * c.a0) + z1;
+        z1 = (input_sample * c.a1) + z2 - (output_sample * c.b1);
+        z2 = (input_sample * c.a2) - (output_sample * c.b2);
+        output_buffer[i] = output_sample;
+    }
+    m_z1 = z1;
+    m_z2 = z2;
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::clean()
 {
     m_z1 = 0;
     m_z2 = 0;
 }
 
-void Biquad::calcCoefficients()
+template<typename sample_type>
+void BasicBiquad<sample_type>::flushDenormals()
+{
+    m_z1 = flushDenormal(m_z1);
+    m_z2 = flushDenormal(m_z2);
+}
+
+template<typename sample_type>
+void BasicBiquad<sample_type>::calcCoefficients()
+{
+    if (m_ramp_length_samples > 0)
+    {
+        rampToCoefficients(designCurrentSetup(), m_ramp_length_samples);
+    }
+    else
+    {
+        setCoefficients(designCurrentSetup());
+    }
+}
+
+template<typename sample_type>
+typename BasicBiquad<sample_type>::Coefficients BasicBiquad<sample_type>::designCurrentSetup()
+{
+    FilterSetup filter_setup;
+    filter_setup.sample_rate_hz = m_sample_rate_hz;
+    filter_setup.cutoff_freq_hz = m_cutoff_freq_hz;
+    filter_setup.quality_factor = m_quality_factor;
+    filter_setup.filter_gain_db = m_filter_gain_db;
+    filter_setup.filter_type = m_filter_type;
+    return m_use_fast_design ? designCoefficientsFast(filter_setup) : designCoefficients(filter_setup);
+}
+
+template<typename sample_type>
+typename BasicBiquad<sample_type>::Coefficients BasicBiquad<sample_type>::designCoefficients(const FilterSetup& filter_setup)
+{
+	sample_type V = pow(10, fabs(filter_setup.filter_gain_db) / 20.0);
+	sample_type K = tan(M_PI * (filter_setup.cutoff_freq_hz / filter_setup.sample_rate_hz));
+    return designFromPrewarpedCutoff(filter_setup, K, V, sqrt(2*V));
+}
+
+template<typename sample_type>
+typename BasicBiquad<sample_type>::Coefficients BasicBiquad<sample_type>::designCoefficientsFast(const FilterSetup& filter_setup)
+{
+    sample_type V = fastDbToLin(fabs(filter_setup.filter_gain_db));
+    sample_type K = fastTanPi(filter_setup.cutoff_freq_hz / filter_setup.sample_rate_hz);
+    return designFromPrewarpedCutoff(filter_setup, K, V, sqrt(2*V));
+}
+
+template<typename sample_type>
+sample_type BasicBiquad<sample_type>::fastTanPi(sample_type normalised_freq)
+{
+    //[5/4] Pade approximant of tan, only used up to PI/4. Above that tan(x) = 1 / tan(PI/2 - x).
+    bool reflect = normalised_freq > 0.25;
+    double x = M_PI * (reflect ? 0.5 - normalised_freq : normalised_freq);
+    double x2 = x * x;
+    double numerator = x * (945.0 - 105.0 * x2 + x2 * x2);
+    double denominator = 945.0 - 420.0 * x2 + 15.0 * x2 * x2;
+    return reflect ? denominator / numerator : numerator / denominator;
+}
+
+template<typename sample_type>
+sample_type BasicBiquad<sample_type>::fastDbToLin(sample_type db_value)
+{
+    //10^(dB/20) = 2^(dB * log2(10)/20), with 2^x split into 2^integer (exponent bits) * 2^fraction (polynomial)
+    double x = db_value * 0.16609640474436813;
+    double integer_part = floor(x);
+    double f = x - integer_part;
+    double fraction_power = 1.0 + f * (0.693147042277 + f * (0.240229325417 + f * (0.0554852186804 + f * (0.00967553606252 + f * (0.00124673406977 + f * 0.000216139442297)))));
+    return ldexp(fraction_power, static_cast<int>(integer_part));
+}
+
+template<typename sample_type>
+constexpr typename BasicBiquad<sample_type>::Coefficients BasicBiquad<sample_type>::designFromPrewarpedCutoff(const FilterSetup& filter_setup, sample_type K, sample_type V, sample_type sqrt_2V)
 {
-    sample_t norm;
-	sample_t V = pow(10, fabs(m_filter_gain_db) / 20.0);
-	sample_t K = tan(M_PI * (m_cutoff_freq_hz / m_sample_rate_hz));
-	switch (m_filter_type) {
+    Coefficients coefficients = {};
+    sample_type norm = 0;
+	switch (filter_setup.filter_type) {
 	case FilterType::LOWPASS:
-		norm = 1 / (1 + K / m_quality_factor + K * K);
-		m_coefficients.a0 = K * K * norm;
-		m_coefficients.a1 = 2 * m_coefficients.a0;
-		m_coefficients.a2 = m_coefficients.a0;
-		m_coefficients.b1 = 2 * (K * K - 1) * norm;
-		m_coefficients.b2 = (1 - K / m_quality_factor + K * K) * norm;
+		norm = 1 / (1 + K / filter_setup.quality_factor + K * K);
+		coefficients.a0 = K * K * norm;
+		coefficients.a1 = 2 * coefficients.a0;
+		coefficients.a2 = coefficients.a0;
+		coefficients.b1 = 2 * (K * K - 1) * norm;
+		coefficients.b2 = (1 - K / filter_setup.quality_factor + K * K) * norm;
 		break;
 	case FilterType::HIGHPASS:
-		norm = 1 / (1 + K / m_quality_factor + K * K);
-		m_coefficients.a0 = 1 * norm;
-		m_coefficients.a1 = -2 * m_coefficients.a0;
-		m_coefficients.a2 = m_coefficients.a0;
-		m_coefficients.b1 = 2 * (K * K - 1) * norm;
-		m_coefficients.b2 = (1 - K / m_quality_factor + K * K) * norm;
+		norm = 1 / (1 + K / filter_setup.quality_factor + K * K);
+		coefficients.a0 = 1 * norm;
+		coefficients.a1 = -2 * coefficients.a0;
+		coefficients.a2 = coefficients.a0;
+		coefficients.b1 = 2 * (K * K - 1) * norm;
+		coefficients.b2 = (1 - K / filter_setup.quality_factor + K * K) * norm;
 		break;
 	case FilterType::BANDPASS:
-		norm = 1 / (1 + K / m_quality_factor + K * K);
-		m_coefficients.a0 = K / m_quality_factor * norm;
-		m_coefficients.a1 = 0;
-		m_coefficients.a2 = -m_coefficients.a0;
-		m_coefficients.b1 = 2 * (K * K - 1) * norm;
-		m_coefficients.b2 = (1 - K / m_quality_factor + K * K) * norm;
+		norm = 1 / (1 + K / filter_setup.quality_factor + K * K);
+		coefficients.a0 = K / filter_setup.quality_factor * norm;
+		coefficients.a1 = 0;
+		coefficients.a2 = -coefficients.a0;
+		coefficients.b1 = 2 * (K * K - 1) * norm;
+		coefficients.b2 = (1 - K / filter_setup.quality_factor + K * K) * norm;
 		break;
 	case FilterType::NOTCH:
-		norm = 1 / (1 + K / m_quality_factor + K * K);
-		m_coefficients.a0 = (1 + K * K) * norm;
-		m_coefficients.a1 = 2 * (K * K - 1) * norm;
-		m_coefficients.a2 = m_coefficients.a0;
-		m_coefficients.b1 = m_coefficients.a1;
-		m_coefficients.b2 = (1 - K / m_quality_factor + K * K) * norm;
+		norm = 1 / (1 + K / filter_setup.quality_factor + K * K);
+		coefficients.a0 = (1 + K * K) * norm;
+		coefficients.a1 = 2 * (K * K - 1) * norm;
+		coefficients.a2 = coefficients.a0;
+		coefficients.b1 = coefficients.a1;
+		coefficients.b2 = (1 - K / filter_setup.quality_factor + K * K) * norm;
 		break;
 	case FilterType::PEAK:
-		if (m_filter_gain_db >= 0) { // boost
-			norm = 1 / (1 + 1/m_quality_factor * K + K * K);
-			m_coefficients.a0 = (1 + V/m_quality_factor * K + K * K) * norm;
-			m_coefficients.a1 = 2 * (K * K - 1) * norm;
-			m_coefficients.a2 = (1 - V/m_quality_factor * K + K * K) * norm;
-			m_coefficients.b1 = m_coefficients.a1;
-			m_coefficients.b2 = (1 - 1/m_quality_factor * K + K * K) * norm;
+		if (filter_setup.filter_gain_db >= 0) { // boost
+			norm = 1 / (1 + 1/filter_setup.quality_factor * K + K * K);
+			coefficients.a0 = (1 + V/filter_setup.quality_factor * K + K * K) * norm;
+			coefficients.a1 = 2 * (K * K - 1) * norm;
+			coefficients.a2 = (1 - V/filter_setup.quality_factor * K + K * K) * norm;
+			coefficients.b1 = coefficients.a1;
+			coefficients.b2 = (1 - 1/filter_setup.quality_factor * K + K * K) * norm;
 		}
 		else { // cut
-			norm = 1 / (1 + V/m_quality_factor * K + K * K);
-			m_coefficients.a0 = (1 + 1/m_quality_factor * K + K * K) * norm;
-			m_coefficients.a1 = 2 * (K * K - 1) * norm;
-			m_coefficients.a2 = (1 - 1/m_quality_factor * K + K * K) * norm;
-			m_coefficients.b1 = m_coefficients.a1;
-			m_coefficients.b2 = (1 - V/m_quality_factor * K + K * K) * norm;
+			norm = 1 / (1 + V/filter_setup.quality_factor * K + K * K);
+			coefficients.a0 = (1 + 1/filter_setup.quality_factor * K + K * K) * norm;
+			coefficients.a1 = 2 * (K * K - 1) * norm;
+			coefficients.a2 = (1 - 1/filter_setup.quality_factor * K + K * K) * norm;
+			coefficients.b1 = coefficients.a1;
+			coefficients.b2 = (1 - V/filter_setup.quality_factor * K + K * K) * norm;
 		}
 		break;
 	case FilterType::LOWSHELF:
-		if (m_filter_gain_db >= 0) { // boost
-			norm = 1 / (1 + sqrt(2) * K + K * K);
-			m_coefficients.a0 = (1 + sqrt(2*V) * K + V * K * K) * norm;
-			m_coefficients.a1 = 2 * (V * K * K - 1) * norm;
-			m_coefficients.a2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
-			m_coefficients.b1 = 2 * (K * K - 1) * norm;
-			m_coefficients.b2 = (1 - sqrt(2) * K + K * K) * norm;
+		if (filter_setup.filter_gain_db >= 0) { // boost
+			norm = 1 / (1 + M_SQRT2 * K + K * K);
+			coefficients.a0 = (1 + sqrt_2V * K + V * K * K) * norm;
+			coefficients.a1 = 2 * (V * K * K - 1) * norm;
+			coefficients.a2 = (1 - sqrt_2V * K + V * K * K) * norm;
+			coefficients.b1 = 2 * (K * K - 1) * norm;
+			coefficients.b2 = (1 - M_SQRT2 * K + K * K) * norm;
 		}
 		else { // cut
-			norm = 1 / (1 + sqrt(2*V) * K + V * K * K);
-			m_coefficients.a0 = (1 + sqrt(2) * K + K * K) * norm;
-			m_coefficients.a1 = 2 * (K * K - 1) * norm;
-			m_coefficients.a2 = (1 - sqrt(2) * K + K * K) * norm;
-			m_coefficients.b1 = 2 * (V * K * K - 1) * norm;
-			m_coefficients.b2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
+			norm = 1 / (1 + sqrt_2V * K + V * K * K);
+			coefficients.a0 = (1 + M_SQRT2 * K + K * K) * norm;
+			coefficients.a1 = 2 * (K * K - 1) * norm;
+			coefficients.a2 = (1 - M_SQRT2 * K + K * K) * norm;
+			coefficients.b1 = 2 * (V * K * K - 1) * norm;
+			coefficients.b2 = (1 - sqrt_2V * K + V * K * K) * norm;
 		}
 		break;
 	case FilterType::HIGHSHELF:
-		if (m_filter_gain_db >= 0) { // boost
-			norm = 1 / (1 + sqrt(2) * K + K * K);
-			m_coefficients.a0 = (V + sqrt(2*V) * K + K * K) * norm;
-			m_coefficients.a1 = 2 * (K * K - V) * norm;
-			m_coefficients.a2 = (V - sqrt(2*V) * K + K * K) * norm;
-			m_coefficients.b1 = 2 * (K * K - 1) * norm;
-			m_coefficients.b2 = (1 - sqrt(2) * K + K * K) * norm;
+		if (filter_setup.filter_gain_db >= 0) { // boost
+			norm = 1 / (1 + M_SQRT2 * K + K * K);
+			coefficients.a0 = (V + sqrt_2V * K + K * K) * norm;
+			coefficients.a1 = 2 * (K * K - V) * norm;
+			coefficients.a2 = (V - sqrt_2V * K + K * K) * norm;
+			coefficients.b1 = 2 * (K * K - 1) * norm;
+			coefficients.b2 = (1 - M_SQRT2 * K + K * K) * norm;
 		}
 		else { // cut
-			norm = 1 / (V + sqrt(2*V) * K + K * K);
-			m_coefficients.a0 = (1 + sqrt(2) * K + K * K) * norm;
-			m_coefficients.a1 = 2 * (K * K - 1) * norm;
-			m_coefficients.a2 = (1 - sqrt(2) * K + K * K) * norm;
-			m_coefficients.b1 = 2 * (K * K - V) * norm;
-			m_coefficients.b2 = (V - sqrt(2*V) * K + K * K) * norm;
+			norm = 1 / (V + sqrt_2V * K + K * K);
+			coefficients.a0 = (1 + M_SQRT2 * K + K * K) * norm;
+			coefficients.a1 = 2 * (K * K - 1) * norm;
+			coefficients.a2 = (1 - M_SQRT2 * K + K * K) * norm;
+			coefficients.b1 = 2 * (K * K - V) * norm;
+			coefficients.b2 = (V - sqrt_2V * K + K * K) * norm;
 		}
 		break;
 	}
+    return coefficients;
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+
+au_BiquadCascade.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+A cascade of second-order sections held in one contiguous array.
+Each sample is passed through every section before moving on to the next sample, so the signal never leaves
+registers between stages and the buffer is only walked once, rather than once per chained Biquad.
+
+Can be set up section by section (e.g. for a parametric EQ) or designed directly as an Nth order
+Butterworth or Linkwitz-Riley lowpass/highpass (e.g. for crossovers).
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_Biquad.h"
+#include <math.h>
+#include <stddef.h>
+
+template<unsigned int max_sections>
+class BiquadCascade
+{
+public:
+
+    BiquadCascade()
+    {
+        for (unsigned int section = 0 ; section < max_sections ; section++)
+        {
+            m_sections[section].coefficients = {1.0, 0.0, 0.0, 0.0, 0.0};
+        }
+        clean();
+    }
+
+    /*
+    Set the number of sections that are processed. Sections above this number are kept but bypassed.
+    */
+    void setNumSections(unsigned int num_sections)
+    {
+        m_num_sections = num_sections > max_sections ? max_sections : num_sections;
+    }
+
+    unsigned int getNumSections()
+    {
+        return m_num_sections;
+    }
+
+    void setSectionCoefficients(unsigned int section, Biquad::Coefficients biquad_coefficients)
+    {
+        m_sections[section].coefficients = biquad_coefficients;
+    }
+
+    Biquad::Coefficients getSectionCoefficients(unsigned int section)
+    {
+        return m_sections[section].coefficients;
+    }
+
+    /*
+    Design a single section, e.g. one band of a parametric EQ.
+    */
+    void setupSection(unsigned int section, Biquad::FilterSetup filter_setup)
+    {
+        m_sections[section].coefficients = Biquad::designCoefficients(filter_setup);
+    }
+
+    /*
+    Design an Nth order Butterworth filter into the cascade. Odd orders use a first order section for the real pole.
+
+    Parameters:
+    filter_type - Biquad::FilterType::LOWPASS or Biquad::FilterType::HIGHPASS
+    order - filter order (slope of 6dB/octave per order)
+
+    Return: false if the order needs more sections than max_sections or filter type is unsupported, true otherwise.
+    */
+    bool designButterworth(Biquad::FilterType filter_type, unsigned int order, sample_t sample_rate_hz, sample_t cutoff_freq_hz)
+    {
+        unsigned int num_sections = (order + 1) / 2;
+        if (order == 0 || num_sections > max_sections || !isCrossoverType(filter_type))
+        {
+            return false;
+        }
+
+        sample_t K = tan(M_PI * (cutoff_freq_hz / sample_rate_hz));
+        unsigned int section = designButterworthSections(filter_type, order, K, 0, true);
+        setNumSections(section);
+        clean();
+        return true;
+    }
+
+    /*
+    Design an Nth order Linkwitz-Riley filter (two cascaded Butterworth filters of half the order) into the cascade.
+    Lowpass and highpass filters with the same order and cutoff sum to an allpass response, for use as crossovers.
+
+    Parameters:
+    filter_type - Biquad::FilterType::LOWPASS or Biquad::FilterType::HIGHPASS
+    order - filter order, must be even (LR2, LR4, LR8 etc.)
+
+    Return: false if the order is odd, needs more sections than max_sections or filter type is unsupported, true otherwise.
+    */
+    bool designLinkwitzRiley(Biquad::FilterType filter_type, unsigned int order, sample_t sample_rate_hz, sample_t cutoff_freq_hz)
+    {
+        unsigned int num_sections = order / 2;
+        if (order == 0 || (order % 2) != 0 || num_sections > max_sections || !isCrossoverType(filter_type))
+        {
+            return false;
+        }
+
+        sample_t K = tan(M_PI * (cutoff_freq_hz / sample_rate_hz));
+        unsigned int butterworth_order = order / 2;
+        unsigned int section = 0;
+
+        //The two first order sections of an odd order Butterworth pair combine into a single Q=0.5 section
+        if (butterworth_order % 2 != 0)
+        {
+            m_sections[section++].coefficients = secondOrderSection(filter_type, K, 0.5);
+        }
+        section = designButterworthSections(filter_type, butterworth_order, K, section, false);
+        section = designButterworthSections(filter_type, butterworth_order, K, section, false);
+        setNumSections(section);
+        clean();
+        return true;
+    }
+
+    sample_t process(sample_t input_sample)
+    {
+        for (unsigned int section = 0 ; section < m_num_sections ; section++)
+        {
+            input_sample = processSection(m_sections[section], input_sample);
+        }
+        return input_sample;
+    }
+
+    /*
+    Process a block of samples through all sections. Input and output can be the same buffer.
+    */
+    void processBlock(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        const unsigned int num_sections = m_num_sections;
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            sample_t sample = input_buffer[i];
+            for (unsigned int section = 0 ; section < num_sections ; section++)
+            {
+                sample = processSection(m_sections[section], sample);
+            }
+            output_buffer[i] = sample;
+        }
+    }
+
+    void clean()
+    {
+        for (unsigned int section = 0 ; section < max_sections ; section++)
+        {
+            m_sections[section].z1 = 0;
+            m_sections[section].z2 = 0;
+        }
+    }
+
+private:
+
+    struct Section
+    {
+        Biquad::Coefficients coefficients;
+        sample_t z1;
+        sample_t z2;
+    };
+
+    static inline sample_t processSection(Section& s, sample_t input_sample)
+    {
+        sample_t output_sample = (input_sample * s.coefficients.a0) + s.z1;
+        s.z1 = (input_sample * s.coefficients.a1) + s.z2 - (output_sample * s.coefficients.b1);
+        s.z2 = (input_sample * s.coefficients.a2) - (output_sample * s.coefficients.b2);
+        return output_sample;
+    }
+
+    static bool isCrossoverType(Biquad::FilterType filter_type)
+    {
+        return filter_type == Biquad::FilterType::LOWPASS || filter_type == Biquad::FilterType::HIGHPASS;
+    }
+
+    //Writes the sections of a Butterworth filter starting at first_section, returns index of the section after the last one written
+    unsigned int designButterworthSections(Biquad::FilterType filter_type, unsigned int order, sample_t K, unsigned int first_section, bool include_real_pole)
+    {
+        unsigned int section = first_section;
+        for (unsigned int pole_pair = 0 ; pole_pair < order / 2 ; pole_pair++)
+        {
+            //Angle of the pole pair from the negative real axis (odd orders have a real pole at 0)
+            sample_t pole_angle = M_PI * (2.0 * pole_pair + 1.0 + (order % 2)) / (2.0 * order);
+            sample_t quality_factor = 1.0 / (2.0 * cos(pole_angle));
+            m_sections[section++].coefficients = secondOrderSection(filter_type, K, quality_factor);
+        }
+        if (include_real_pole && order % 2 != 0)
+        {
+            m_sections[section++].coefficients = firstOrderSection(filter_type, K);
+        }
+        return section;
+    }
+
+    static Biquad::Coefficients secondOrderSection(Biquad::FilterType filter_type, sample_t K, sample_t quality_factor)
+    {
+        Biquad::Coefficients coefficients;
+        sample_t norm = 1 / (1 + K / quality_factor + K * K);
+        if (filter_type == Biquad::FilterType::LOWPASS)
+        {
+            coefficients.a0 = K * K * norm;
+            coefficients.a1 = 2 * coefficients.a0;
+        }
+        else
+        {
+            coefficients.a0 = norm;
+            coefficients.a1 = -2 * coefficients.a0;
+        }
+        coefficients.a2 = coefficients.a0;
+        coefficients.b1 = 2 * (K * K - 1) * norm;
+        coefficients.b2 = (1 - K / quality_factor + K * K) * norm;
+        return coefficients;
+    }
+
+    static Biquad::Coefficients firstOrderSection(Biquad::FilterType filter_type, sample_t K)
+    {
+        Biquad::Coefficients coefficients;
+        sample_t norm = 1 / (1 + K);
+        if (filter_type == Biquad::FilterType::LOWPASS)
+        {
+            coefficients.a0 = K * norm;
+            coefficients.a1 = coefficients.a0;
+        }
+        else
+        {
+            coefficients.a0 = norm;
+            coefficients.a1 = -coefficients.a0;
+        }
+        coefficients.a2 = 0;
+        coefficients.b1 = (K - 1) * norm;
+        coefficients.b2 = 0;
+        return coefficients;
+    }
+
+    Section m_sections[max_sections];
+    unsigned int m_num_sections = 0;
+};
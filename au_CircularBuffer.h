@@ -5,24 +5,54 @@ au_CircularBuffer.h
 Author: Matt Davison
 Date: 30/12/2023
 
+Single threaded circular buffer (see SpscCircularBuffer for passing data between threads).
+
+Power of two lengths wrap with a mask rather than a modulo. Blocks can be moved without per element calls:
+- write(const T*, n)/read(T*, n) copy whole blocks.
+- prepareWrite()/commitWrite() and peekRead()/consumeRead() give direct access to the ring storage as up to two contiguous
+  Spans (the second is only used when the region wraps past the end of the buffer), so data can be decoded straight into
+  the buffer, or processed straight out of it (e.g. with Biquad::processBlock()) without an intermediate copy.
+
 */
 
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <stddef.h>
+
 template<typename T, unsigned long buffer_length>
 class CircularBuffer
 {
 public:
 
+    /*
+    A region of the buffer, as up to two contiguous parts. second_length is 0 if the region doesn't wrap.
+    */
+    struct Spans
+    {
+        T* first = nullptr;
+        size_t first_length = 0;
+        T* second = nullptr;
+        size_t second_length = 0;
+
+        size_t size() const
+        {
+            return first_length + second_length;
+        }
+    };
+
     void write(T new_buffer_val)
     {
         m_buffer[m_write_index++] = new_buffer_val;
 
         //Detect overrun - write point is more than buffer length ahead of the read point
-        if (++m_read_write_distance > buffer_length)
+        if (++m_read_write_distance > static_cast<long>(buffer_length))
         {
             m_overrun = true;
         }
 
-        m_write_index = m_write_index % buffer_length;
+        m_write_index = wrapIndex(m_write_index);
     }
 
     T read()
@@ -35,10 +65,88 @@ public:
             m_underrun = true;
         }
 
-        m_read_index = m_read_index % buffer_length;
+        m_read_index = wrapIndex(m_read_index);
         return read_val;
     }
 
+    /*
+    Write a block of values. Only writes as many values as there is free space for, unread values are never overwritten.
+
+    Return: number of values written. If less than num_values, the overrun flag is set.
+    */
+    size_t write(const T* values, size_t num_values)
+    {
+        Spans spans = prepareWrite(num_values);
+        std::copy(values, values + spans.first_length, spans.first);
+        std::copy(values + spans.first_length, values + spans.size(), spans.second);
+        commitWrite(spans.size());
+        if (spans.size() < num_values)
+        {
+            m_overrun = true;
+        }
+        return spans.size();
+    }
+
+    /*
+    Read a block of values.
+
+    Return: number of values read. If less than num_values, the buffer ran empty and the underrun flag is set.
+    */
+    size_t read(T* values, size_t num_values)
+    {
+        Spans spans = peekRead(num_values);
+        std::copy(spans.first, spans.first + spans.first_length, values);
+        std::copy(spans.second, spans.second + spans.second_length, values + spans.first_length);
+        consumeRead(spans.size());
+        if (spans.size() < num_values)
+        {
+            m_underrun = true;
+        }
+        return spans.size();
+    }
+
+    /*
+    Get free space to write up to num_values into directly. Nothing is added to the buffer until commitWrite() is called.
+
+    Return: spans covering min(num_values, free space) values
+    */
+    Spans prepareWrite(size_t num_values)
+    {
+        return getSpans(m_write_index, num_values < freeSpace() ? num_values : freeSpace());
+    }
+
+    /*
+    Add num_values values written through the spans from prepareWrite() to the buffer. Must not be more than the size of those spans.
+    */
+    void commitWrite(size_t num_values)
+    {
+        m_write_index = wrapIndex(m_write_index + num_values);
+        m_read_write_distance += num_values;
+    }
+
+    /*
+    Get up to num_values of the oldest values in the buffer without removing them.
+
+    Return: spans covering min(num_values, itemsInBuffer()) values
+    */
+    Spans peekRead(size_t num_values)
+    {
+        //The distance can pass either end after a single element overrun/underrun, so clamp to what's in the storage
+        long num_items = m_read_write_distance < 0 ? 0 : m_read_write_distance;
+        num_items = num_items > static_cast<long>(buffer_length) ? static_cast<long>(buffer_length) : num_items;
+        return getSpans(m_read_index, num_values < static_cast<size_t>(num_items) ? num_values : static_cast<size_t>(num_items));
+    }
+
+    /*
+    Remove num_values values from the buffer, e.g. after processing them through the spans from peekRead(). Must not be more
+    than the size of those spans.
+    */
+    void consumeRead(size_t num_values)
+    {
+        m_read_index = wrapIndex(m_read_index + num_values);
+        m_read_write_distance -= num_values;
+    }
+
     bool overRun()
     {
         bool has_overrun = m_overrun;
@@ -58,8 +166,46 @@ public:
         return m_read_write_distance;
     }
 
+    /*
+    Empty the buffer.
+    */
+    void clear()
+    {
+        m_write_index = 0;
+        m_read_index = 0;
+        m_read_write_distance = 0;
+    }
+
 private:
-    T m_buffer[buffer_length]; 
+
+    static constexpr bool LENGTH_IS_POWER_OF_TWO = (buffer_length & (buffer_length - 1)) == 0;
+
+    static unsigned long wrapIndex(unsigned long index)
+    {
+        return LENGTH_IS_POWER_OF_TWO ? (index & (buffer_length - 1)) : (index % buffer_length);
+    }
+
+    size_t freeSpace()
+    {
+        //Clamped to 0 - buffer_length, as the distance can go negative after a single element underrun
+        long free_space = static_cast<long>(buffer_length) - m_read_write_distance;
+        free_space = free_space > static_cast<long>(buffer_length) ? static_cast<long>(buffer_length) : free_space;
+        return free_space > 0 ? free_space : 0;
+    }
+
+    Spans getSpans(unsigned long start_index, size_t num_values)
+    {
+        assert(num_values <= buffer_length);
+        Spans spans;
+        size_t to_end = buffer_length - start_index;
+        spans.first = &m_buffer[start_index];
+        spans.first_length = num_values < to_end ? num_values : to_end;
+        spans.second = m_buffer;
+        spans.second_length = num_values - spans.first_length;
+        return spans;
+    }
+
+    T m_buffer[buffer_length];
     unsigned long m_write_index = 0;
     unsigned long m_read_index = 0;
 
@@ -68,4 +214,4 @@ private:
     //Flags to detect over/under runs of buffer - set when it occurs during read/write, cleared after calling respective flag getter functions (overRun() and underRun() )
     bool m_overrun = false;
     bool m_underrun = false;
-};
\ No newline at end of file
+};
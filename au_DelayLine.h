@@ -5,8 +5,14 @@ au_DelayLine.h
 Author: Matt Davison
 Date: 31/12/2023
 
+Integer delay line. The whole buffer is always used as a ring and the output is read delay length samples behind the write
+point, so the delay length can be changed without disturbing the buffer contents. See FractionalDelayLine for fractional,
+interpolated and modulated delays.
+
 */
 
+#pragma once
+
 template<typename T, unsigned long max_buffer_length>
 class DelayLine
 {
@@ -14,7 +20,7 @@ public:
 
     void setDelayLength(unsigned long delay_length_samples)
     {
-        m_delay_length_samples = delay_length_samples;
+        m_delay_length_samples = delay_length_samples < max_buffer_length ? delay_length_samples : max_buffer_length;
     }
 
     T step(T write_value)
@@ -27,17 +33,27 @@ public:
 
     T read()
     {
-        return m_buffer[m_index];
+        return m_buffer[(m_index + max_buffer_length - m_delay_length_samples) % max_buffer_length];
     }
 
-    write(T write_value)
+    void write(T write_value)
     {
         m_buffer[m_index] = write_value;
     }
 
     void step()
     {
-        m_index = (m_index + 1) % m_delay_length_samples;
+        //Constant modulo, a mask for power of two lengths
+        m_index = (m_index + 1) % max_buffer_length;
+    }
+
+    void clear()
+    {
+        for (unsigned long i = 0 ; i < max_buffer_length ; i++)
+        {
+            m_buffer[i] = 0;
+        }
+        m_index = 0;
     }
 
 private:
@@ -0,0 +1,106 @@
+/*
+
+au_Denormals.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Protection against denormal (subnormal) floats.
+
+When the input to a recursive processor (Biquad, Onepole, KarplusStrong, reverb tails etc) goes silent, its state decays
+towards zero and eventually becomes denormal. Many CPUs, x86 in particular, handle denormals 10-100x slower than normal
+floats, so CPU use rises sharply just when the audio goes quiet. Two ways to avoid it:
+
+ScopedFlushToZero - RAII: while it exists, the current thread's floating point unit treats denormal results and inputs as zero
+    (flush to zero and denormals are zero). Create one at the top of each audio callback, and the previous mode is restored when
+    it goes out of scope. Supported on x86 (SSE) and ARM (32 and 64 bit, GCC/Clang), does nothing elsewhere (IS_SUPPORTED).
+
+flushDenormals() on recursive processors - zeroes state that has decayed below DENORMAL_FLUSH_THRESHOLD (-300dB). For when
+    the floating point mode can't be changed (e.g. it's owned by a plugin host). Opt in by calling it once per block: the state
+    can't decay from the threshold into the denormal range within a block, so the tail never reaches denormals.
+
+*/
+
+#pragma once
+
+#include "stdint.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AU_DENORMALS_X86
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define AU_DENORMALS_ARM64
+#elif defined(__arm__) && defined(__GNUC__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+#define AU_DENORMALS_ARM32
+#endif
+
+//Values smaller than this (-300dB) are flushed by flushDenormal(). Far below audibility, and far above the denormal range.
+constexpr double DENORMAL_FLUSH_THRESHOLD = 1e-15;
+
+/*
+Return: 0 if value is within +/-DENORMAL_FLUSH_THRESHOLD, otherwise value. Branch free so it vectorises over buffers.
+*/
+template<typename sample_type>
+sample_type flushDenormal(sample_type value)
+{
+    const sample_type threshold = static_cast<sample_type>(DENORMAL_FLUSH_THRESHOLD);
+    return (value < threshold && value > -threshold) ? static_cast<sample_type>(0) : value;
+}
+
+class ScopedFlushToZero
+{
+public:
+
+#if defined(AU_DENORMALS_X86) || defined(AU_DENORMALS_ARM64) || defined(AU_DENORMALS_ARM32)
+    static constexpr bool IS_SUPPORTED = true;
+#else
+    static constexpr bool IS_SUPPORTED = false;
+#endif
+
+    ScopedFlushToZero()
+    {
+#if defined(AU_DENORMALS_X86)
+        m_previous_mode = _mm_getcsr();
+        _mm_setcsr(m_previous_mode | FTZ_BIT | DAZ_BIT);
+#elif defined(AU_DENORMALS_ARM64)
+        uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        m_previous_mode = fpcr;
+        fpcr |= FZ_BIT;
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+#elif defined(AU_DENORMALS_ARM32)
+        uint32_t fpscr;
+        __asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+        m_previous_mode = fpscr;
+        fpscr |= FZ_BIT;
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr));
+#endif
+    }
+
+    ~ScopedFlushToZero()
+    {
+#if defined(AU_DENORMALS_X86)
+        _mm_setcsr(m_previous_mode);
+#elif defined(AU_DENORMALS_ARM64)
+        uint64_t fpcr = m_previous_mode;
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+#elif defined(AU_DENORMALS_ARM32)
+        uint32_t fpscr = static_cast<uint32_t>(m_previous_mode);
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr));
+#endif
+    }
+
+    ScopedFlushToZero(const ScopedFlushToZero&) = delete;
+    ScopedFlushToZero& operator=(const ScopedFlushToZero&) = delete;
+
+private:
+
+#if defined(AU_DENORMALS_X86)
+    static constexpr unsigned int FTZ_BIT = 0x8000;
+    static constexpr unsigned int DAZ_BIT = 0x0040;
+    unsigned int m_previous_mode;
+#else
+    static constexpr uint32_t FZ_BIT = 1u << 24;
+    uint64_t m_previous_mode = 0;
+#endif
+};
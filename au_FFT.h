@@ -0,0 +1,298 @@
+/*
+
+au_FFT.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+In-place real FFT for power of two sizes. A plan (twiddle factors and bit reversal swaps) is calculated once in setup(),
+which allocates, so should be called outside of the audio thread. forward() and inverse() do not allocate.
+
+The real transform of N samples is done as an N/2 point complex FFT (decimation in time, a radix-4 first pass then radix-2 stages)
+followed by a split step. Twiddles for each butterfly stage are stored contiguously, so the inner butterfly loop runs over
+sequential memory and is vectorised by the compiler.
+
+Spectrum layout (N values, in place of the input):
+    buffer[0] = DC (real), buffer[1] = Nyquist (real)
+    buffer[2k], buffer[2k+1] = real, imaginary parts of bin k for k = 1 to N/2 - 1
+
+Accuracy, against a double precision direct DFT with white noise input (tests/test_FFT.cpp), as the largest error relative to
+the largest bin: forward up to 1.7e-7 for N = 4 to 8192, and inverse(forward(x)) within 4.8e-7 of x relative to its peak.
+
+Goertzel or FFT?
+A Goertzel bin costs around N multiply-adds, while the whole FFT costs around N*log2(N) operations, so for a handful of bins
+Goertzel (or GoertzelBank) is cheaper. preferGoertzel() gives the crossover point.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include <math.h>
+#include <utility>
+#include <vector>
+
+class FFT
+{
+public:
+
+    FFT(int fft_size = 0)
+    {
+        if (fft_size > 0)
+        {
+            setup(fft_size);
+        }
+    }
+
+    /*
+    Calculate the plan for a given size.
+
+    Parameters:
+    fft_size - number of real samples, must be a power of two and at least 4
+
+    Return: false if the size isn't supported
+    */
+    bool setup(int fft_size)
+    {
+        if (fft_size < 4 || (fft_size & (fft_size - 1)) != 0)
+        {
+            return false;
+        }
+        m_fft_size = fft_size;
+        int complex_size = fft_size / 2;
+
+        //Bit reversal swaps for the complex FFT
+        m_bit_reverse_swaps.clear();
+        int num_bits = 0;
+        while ((1 << num_bits) < complex_size)
+        {
+            num_bits++;
+        }
+        for (int i = 0 ; i < complex_size ; i++)
+        {
+            int reversed = 0;
+            for (int bit = 0 ; bit < num_bits ; bit++)
+            {
+                reversed |= ((i >> bit) & 1) << (num_bits - 1 - bit);
+            }
+            if (i < reversed)
+            {
+                m_bit_reverse_swaps.push_back(std::make_pair(i, reversed));
+            }
+        }
+
+        //Stage twiddles, stage with butterfly span 'half' stores its 'half' twiddles starting at index (half - 1)
+        m_stage_twiddles_real.resize(complex_size);
+        m_stage_twiddles_imaginary.resize(complex_size);
+        for (int half = 1 ; half < complex_size ; half *= 2)
+        {
+            for (int j = 0 ; j < half ; j++)
+            {
+                double angle = -M_PI * j / half;
+                m_stage_twiddles_real[half - 1 + j] = cos(angle);
+                m_stage_twiddles_imaginary[half - 1 + j] = sin(angle);
+            }
+        }
+
+        //Twiddles for splitting the complex FFT into the real spectrum
+        m_split_twiddles_real.resize(complex_size / 2 + 1);
+        m_split_twiddles_imaginary.resize(complex_size / 2 + 1);
+        for (int k = 0 ; k <= complex_size / 2 ; k++)
+        {
+            double angle = -2.0 * M_PI * k / fft_size;
+            m_split_twiddles_real[k] = cos(angle);
+            m_split_twiddles_imaginary[k] = sin(angle);
+        }
+        return true;
+    }
+
+    int getSize()
+    {
+        return m_fft_size;
+    }
+
+    /*
+    Forward transform of getSize() real samples, in place. See top of file for the spectrum layout. Unscaled.
+    */
+    void forward(sample_t* buffer)
+    {
+        const int complex_size = m_fft_size / 2;
+        complexTransform(buffer, false);
+
+        //Split: X[k] = 0.5 * (Z[k] + conj(Z[M-k])) - 0.5j * W^k * (Z[k] - conj(Z[M-k]))
+        sample_t dc = buffer[0] + buffer[1];
+        sample_t nyquist = buffer[0] - buffer[1];
+        buffer[0] = dc;
+        buffer[1] = nyquist;
+        for (int k = 1 ; k <= complex_size / 2 ; k++)
+        {
+            int mirror = complex_size - k;
+            sample_t z_real = buffer[2 * k];
+            sample_t z_imaginary = buffer[2 * k + 1];
+            sample_t zm_real = buffer[2 * mirror];
+            sample_t zm_imaginary = buffer[2 * mirror + 1];
+
+            sample_t even_real = 0.5f * (z_real + zm_real);
+            sample_t even_imaginary = 0.5f * (z_imaginary - zm_imaginary);
+            sample_t odd_real = 0.5f * (z_imaginary + zm_imaginary);
+            sample_t odd_imaginary = -0.5f * (z_real - zm_real);
+
+            sample_t w_real = m_split_twiddles_real[k];
+            sample_t w_imaginary = m_split_twiddles_imaginary[k];
+            sample_t t_real = (w_real * odd_real) - (w_imaginary * odd_imaginary);
+            sample_t t_imaginary = (w_real * odd_imaginary) + (w_imaginary * odd_real);
+
+            buffer[2 * k] = even_real + t_real;
+            buffer[2 * k + 1] = even_imaginary + t_imaginary;
+            //X[M-k] = conj(even) - conj(t), using W^(M-k) = -conj(W^k)
+            buffer[2 * mirror] = even_real - t_real;
+            buffer[2 * mirror + 1] = t_imaginary - even_imaginary;
+        }
+    }
+
+    /*
+    Inverse transform of a spectrum in the layout produced by forward(), in place. Scaled so inverse(forward(x)) == x.
+    */
+    void inverse(sample_t* buffer)
+    {
+        const int complex_size = m_fft_size / 2;
+
+        //Undo split: Z[k] = E[k] + j * O[k], with E = 0.5 * (X[k] + conj(X[M-k])), O = 0.5 * conj(W^k) * (X[k] - conj(X[M-k]))
+        sample_t dc = buffer[0];
+        sample_t nyquist = buffer[1];
+        buffer[0] = 0.5f * (dc + nyquist);
+        buffer[1] = 0.5f * (dc - nyquist);
+        for (int k = 1 ; k <= complex_size / 2 ; k++)
+        {
+            int mirror = complex_size - k;
+            sample_t x_real = buffer[2 * k];
+            sample_t x_imaginary = buffer[2 * k + 1];
+            sample_t xm_real = buffer[2 * mirror];
+            sample_t xm_imaginary = buffer[2 * mirror + 1];
+
+            sample_t even_real = 0.5f * (x_real + xm_real);
+            sample_t even_imaginary = 0.5f * (x_imaginary - xm_imaginary);
+            sample_t diff_real = 0.5f * (x_real - xm_real);
+            sample_t diff_imaginary = 0.5f * (x_imaginary + xm_imaginary);
+
+            sample_t w_real = m_split_twiddles_real[k];
+            sample_t w_imaginary = -m_split_twiddles_imaginary[k];
+            sample_t odd_real = (w_real * diff_real) - (w_imaginary * diff_imaginary);
+            sample_t odd_imaginary = (w_real * diff_imaginary) + (w_imaginary * diff_real);
+
+            //Z[k] = E + jO, Z[M-k] = conj(E) + j*conj(O) (O[M-k] = conj(O[k]))
+            buffer[2 * k] = even_real - odd_imaginary;
+            buffer[2 * k + 1] = even_imaginary + odd_real;
+            buffer[2 * mirror] = even_real + odd_imaginary;
+            buffer[2 * mirror + 1] = odd_real - even_imaginary;
+        }
+
+        complexTransform(buffer, true);
+
+        sample_t scale = 1.0f / complex_size;
+        for (int i = 0 ; i < m_fft_size ; i++)
+        {
+            buffer[i] *= scale;
+        }
+    }
+
+    /*
+    Get the magnitude of each bin from a spectrum produced by forward().
+
+    Parameters:
+    magnitudes - buffer of getSize() / 2 + 1 values (DC to Nyquist)
+    */
+    void getMagnitudes(const sample_t* spectrum, sample_t* magnitudes)
+    {
+        const int num_complex_bins = m_fft_size / 2;
+        magnitudes[0] = fabs(spectrum[0]);
+        magnitudes[num_complex_bins] = fabs(spectrum[1]);
+        for (int k = 1 ; k < num_complex_bins ; k++)
+        {
+            magnitudes[k] = sqrt((spectrum[2 * k] * spectrum[2 * k]) + (spectrum[2 * k + 1] * spectrum[2 * k + 1]));
+        }
+    }
+
+    /*
+    Returns true if calculating num_bins bins with Goertzel over a window of window_length samples is expected to be
+    cheaper than a full FFT of that length.
+    */
+    static bool preferGoertzel(int num_bins, int window_length)
+    {
+        int log2_length = 0;
+        while ((1 << log2_length) < window_length)
+        {
+            log2_length++;
+        }
+        return num_bins <= log2_length;
+    }
+
+private:
+
+    //Complex FFT of getSize() / 2 interleaved (real, imaginary) values. Inverse transform is unscaled.
+    void complexTransform(sample_t* data, bool inverse)
+    {
+        const int complex_size = m_fft_size / 2;
+
+        for (const std::pair<int, int>& swap : m_bit_reverse_swaps)
+        {
+            std::swap(data[2 * swap.first], data[2 * swap.second]);
+            std::swap(data[2 * swap.first + 1], data[2 * swap.second + 1]);
+        }
+
+        const sample_t imaginary_sign = inverse ? -1.0f : 1.0f;
+        int first_half = 1;
+        if (complex_size >= 4)
+        {
+            //First two stages as one radix-4 pass, their twiddles are 1 and -j (+j for inverse) so need no multiplies
+            for (int start = 0 ; start < complex_size ; start += 4)
+            {
+                sample_t* d = &data[2 * start];
+                sample_t b0_real = d[0] + d[2], b0_imaginary = d[1] + d[3];
+                sample_t b1_real = d[0] - d[2], b1_imaginary = d[1] - d[3];
+                sample_t b2_real = d[4] + d[6], b2_imaginary = d[5] + d[7];
+                sample_t b3_real = d[4] - d[6], b3_imaginary = d[5] - d[7];
+                sample_t t_real = imaginary_sign * b3_imaginary;
+                sample_t t_imaginary = -imaginary_sign * b3_real;
+                d[0] = b0_real + b2_real;
+                d[1] = b0_imaginary + b2_imaginary;
+                d[4] = b0_real - b2_real;
+                d[5] = b0_imaginary - b2_imaginary;
+                d[2] = b1_real + t_real;
+                d[3] = b1_imaginary + t_imaginary;
+                d[6] = b1_real - t_real;
+                d[7] = b1_imaginary - t_imaginary;
+            }
+            first_half = 4;
+        }
+
+        for (int half = first_half ; half < complex_size ; half *= 2)
+        {
+            const sample_t* twiddles_real = &m_stage_twiddles_real[half - 1];
+            const sample_t* twiddles_imaginary = &m_stage_twiddles_imaginary[half - 1];
+            for (int start = 0 ; start < complex_size ; start += 2 * half)
+            {
+                sample_t* top = &data[2 * start];
+                sample_t* bottom = &data[2 * (start + half)];
+                for (int j = 0 ; j < half ; j++)
+                {
+                    sample_t w_real = twiddles_real[j];
+                    sample_t w_imaginary = imaginary_sign * twiddles_imaginary[j];
+                    sample_t t_real = (w_real * bottom[2 * j]) - (w_imaginary * bottom[2 * j + 1]);
+                    sample_t t_imaginary = (w_real * bottom[2 * j + 1]) + (w_imaginary * bottom[2 * j]);
+                    bottom[2 * j] = top[2 * j] - t_real;
+                    bottom[2 * j + 1] = top[2 * j + 1] - t_imaginary;
+                    top[2 * j] += t_real;
+                    top[2 * j + 1] += t_imaginary;
+                }
+            }
+        }
+    }
+
+    int m_fft_size = 0;
+    std::vector<std::pair<int, int>> m_bit_reverse_swaps;
+    std::vector<sample_t> m_stage_twiddles_real;
+    std::vector<sample_t> m_stage_twiddles_imaginary;
+    std::vector<sample_t> m_split_twiddles_real;
+    std::vector<sample_t> m_split_twiddles_imaginary;
+};
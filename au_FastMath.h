@@ -0,0 +1,307 @@
+/*
+
+au_FastMath.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Fast float approximations of exp2, log2, dB conversion, sin, cos, tan and tanh, each with three accuracy tiers.
+
+Every function is a short polynomial (or rational) with no tables, branches or libm calls, so the block versions vectorise.
+Polynomials are minimax fits, and exponent/mantissa handling is done directly on the float bits, so these are float only.
+
+Maximum error measured against double precision libm (dense sweep over the stated range, float input, see
+tests/test_FastMath.cpp, which checks these limits), rounded up:
+
+Function        Range                   LOW             MEDIUM          HIGH
+exp2            -126 to 127             7.5e-5 rel      2.7e-6 rel      1.1e-7 rel
+log2            0.5 to 2                5.7e-6 abs      1.5e-7 abs      1.2e-7 abs
+dBToLin         -700 to 700dB           7.8e-5 rel      5.6e-6 rel      3.0e-6 rel
+                                        (0.00068dB)     (0.000049dB)    (0.000026dB)
+linTodB         1e-6 to 1e3             4.5e-5dB        1.2e-5dB        1.2e-5dB
+sin, cos        -PI to PI               1.1e-4 abs      1.2e-6 abs      3.6e-7 abs
+tan             -1.5 to 1.5             2.2e-4 rel      3.0e-6 rel      3.0e-6 rel
+tanh            all                     2.4e-2 abs      1.4e-6 abs      1.4e-7 abs
+
+Outside 0.5 to 2, log2 (and so linTodB) adds the float rounding of the result, e.g. up to 3.8e-6 for results around +/-100.
+The HIGH dBToLin/linTodB figures are set by float rounding of the scaled argument/result, not the polynomials.
+
+Limits:
+- exp2 input is clamped to -126 to 127 (no infinities or denormals), so dBToLin is too.
+- log2 input below the smallest normal float (including 0, negative values and NaN) is treated as 2^-126, so linTodB(0) is
+  around -758dB rather than -infinity. linTodB uses the magnitude of its input, like linTodB() in au_config.h.
+- sin/cos/tan range reduction is done in float, so absolute error grows with the size of the argument, as with any float
+  phase. Keep phases wrapped (e.g. -PI to PI) for the accuracy above.
+- tan accuracy falls near its poles (+/-PI/2).
+
+Usage:
+    sample_t gain = FastMath::dBToLin(level_db);                            //MEDIUM (default)
+    sample_t fine_gain = FastMath::dBToLin<FastMath::Accuracy::HIGH>(level_db);
+    FastMath::sin<FastMath::Accuracy::LOW>(phase_buffer, output_buffer, num_samples);
+
+*/
+
+#pragma once
+
+#include "stdint.h"
+#include <stddef.h>
+#include <string.h>
+
+class FastMath
+{
+public:
+
+    enum class Accuracy
+    {
+        LOW,
+        MEDIUM,
+        HIGH
+    };
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float exp2(float x)
+    {
+        //Written so NaN fails both compares and is clamped
+        x = select(x < 127.0f, x, 127.0f);
+        x = select(x > -126.0f, x, -126.0f);
+
+        //2^x = 2^integer (exponent bits) * 2^fraction (polynomial)
+        int32_t integer_part = static_cast<int32_t>(x);
+        integer_part -= x < static_cast<float>(integer_part) ? 1 : 0;
+        float f = x - static_cast<float>(integer_part);
+
+        float fraction_power;
+        if (accuracy == Accuracy::LOW)
+        {
+            fraction_power = 0.999925194f + f * (0.695833640f + f * (0.226067226f + f * 0.0780243044f));
+        }
+        else if (accuracy == Accuracy::MEDIUM)
+        {
+            fraction_power = 1.00000259f + f * (0.693003833f + f * (0.241442751f + f * (0.0520114843f + f * 0.0135341497f)));
+        }
+        else
+        {
+            fraction_power = 1.0f + f * (0.693146984f + f * (0.240229836f + f * (0.0554833424f + f * (0.00967884045f
+                           + f * (0.00124396909f + f * 0.000217022502f)))));
+        }
+
+        return fraction_power * fromBits((integer_part + 127) << 23);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float log2(float x)
+    {
+        //Written so NaN fails the compare and is clamped
+        x = select(x > SMALLEST_NORMAL, x, SMALLEST_NORMAL);
+
+        //Split into exponent and a mantissa in [sqrt(0.5), sqrt(2)), so the polynomial is centred on log2(1) = 0
+        int32_t bits = toBits(x);
+        int32_t exponent = (bits - SQRT_HALF_BITS) >> 23;
+        float mantissa = fromBits(bits - (exponent << 23));
+
+        //log2(m) = (2 / ln(2)) * atanh(t) for t = (m - 1) / (m + 1), which is an odd series in t
+        float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+        float t2 = t * t;
+        float series;
+        if (accuracy == Accuracy::LOW)
+        {
+            series = 2.88522858f + t2 * 0.983534107f;
+        }
+        else if (accuracy == Accuracy::MEDIUM)
+        {
+            series = 2.88539129f + t2 * (0.961470798f + t2 * 0.598974262f);
+        }
+        else
+        {
+            series = 2.88539007f + t2 * (0.961800759f + t2 * (0.576584520f + t2 * 0.434256433f));
+        }
+        return static_cast<float>(exponent) + (t * series);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float dBToLin(float db_value)
+    {
+        //10^(dB / 20) = 2^(dB * log2(10) / 20)
+        return exp2<accuracy>(db_value * 0.166096405f);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float linTodB(float lin_value)
+    {
+        //20 * log10(|x|) = 20 * log10(2) * log2(|x|)
+        float magnitude = fromBits(toBits(lin_value) & 0x7FFFFFFF);
+        return log2<accuracy>(magnitude) * 6.02059991f;
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float sin(float x)
+    {
+        return sinTurns<accuracy>(x * INVERSE_TWO_PI);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float cos(float x)
+    {
+        return sinTurns<accuracy>((x * INVERSE_TWO_PI) + 0.25f);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float tan(float x)
+    {
+        float turns = x * INVERSE_TWO_PI;
+        return sinTurns<accuracy>(turns) / sinTurns<accuracy>(turns + 0.25f);
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static float tanh(float x)
+    {
+        if (accuracy == Accuracy::LOW)
+        {
+            //Pade approximant, which reaches exactly +/-1 at +/-3
+            x = select(x < 3.0f, x, 3.0f);
+            x = select(x > -3.0f, x, -3.0f);
+            float x2 = x * x;
+            return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        }
+        //tanh(x) = (e^2x - 1) / (e^2x + 1). Beyond +/-9 tanh is 1 to float precision.
+        x = select(x < 9.0f, x, 9.0f);
+        x = select(x > -9.0f, x, -9.0f);
+        float e2x = exp2<accuracy>(x * 2.88539008f);
+        return (e2x - 1.0f) / (e2x + 1.0f);
+    }
+
+    /*
+    Block versions, e.g. FastMath::sin(phase_buffer, output_buffer, num_samples). Output can be the same buffer as input.
+    */
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void exp2(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = exp2<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void log2(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = log2<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void dBToLin(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = dBToLin<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void linTodB(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = linTodB<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void sin(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = sin<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void cos(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = cos<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void tan(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = tan<accuracy>(input_buffer[i]);
+        }
+    }
+
+    template<Accuracy accuracy = Accuracy::MEDIUM>
+    static void tanh(const float* input_buffer, float* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = tanh<accuracy>(input_buffer[i]);
+        }
+    }
+
+private:
+
+    static constexpr float INVERSE_TWO_PI = 0.159154943f;
+    static constexpr float SMALLEST_NORMAL = 1.17549435e-38f;
+    static constexpr int32_t SQRT_HALF_BITS = 0x3F3504F3;
+    static constexpr float MAX_TURNS = 8388608.0f; //2^23, above which every float is a whole number of turns
+
+    static int32_t toBits(float value)
+    {
+        int32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static float fromBits(int32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /*
+    condition ? if_true : if_false, done with an integer mask. GCC turns a plain ?: between floats into a branch when one side is
+    a constant (it threads the constant through the rest of the calculation), which stops the block loops vectorising.
+    */
+    static float select(bool condition, float if_true, float if_false)
+    {
+        int32_t mask = -static_cast<int32_t>(condition);
+        return fromBits((toBits(if_true) & mask) | (toBits(if_false) & ~mask));
+    }
+
+    //sin(2 * PI * turns)
+    template<Accuracy accuracy>
+    static float sinTurns(float turns)
+    {
+        //Reduce to -0.5 to 0.5 turns (clamped first so the conversion to int can't overflow), then fold into -0.25 to 0.25,
+        //where sin is odd and monotonic
+        turns = select(turns < MAX_TURNS, turns, MAX_TURNS);
+        turns = select(turns > -MAX_TURNS, turns, -MAX_TURNS);
+        float r = turns - static_cast<float>(static_cast<int32_t>(turns + select(turns < 0, -0.5f, 0.5f)));
+        r = select(r > 0.25f, 0.5f - r, r);
+        r = select(r < -0.25f, -0.5f - r, r);
+
+        float r2 = r * r;
+        float series;
+        if (accuracy == Accuracy::LOW)
+        {
+            series = 6.28250423f + r2 * (-41.1663651f + r2 * 74.4515176f);
+        }
+        else if (accuracy == Accuracy::MEDIUM)
+        {
+            series = 6.28317939f + r2 * (-41.3389409f + r2 * (81.3953094f + r2 * -71.4742527f));
+        }
+        else
+        {
+            series = 6.28318527f + r2 * (-41.3416775f + r2 * (81.6022303f + r2 * (-76.5749718f + r2 * 39.7107713f)));
+        }
+        return r * series;
+    }
+};
@@ -0,0 +1,315 @@
+/*
+
+au_FdnReverb.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Stereo feedback delay network reverb.
+
+num_lines delay lines (a power of two, e.g. 8 or 16) are fed back into each other through a lossless mixing matrix:
+HADAMARD - every line feeds every other line with equal weight (densest), done as a fast Walsh-Hadamard transform (N*log2(N) adds)
+HOUSEHOLDER - reflection I - (2/N) * 1 * 1^T, N adds and N multiplies, slightly less dense
+
+Each line has a decay gain (set from the RT60 decay time and its length) and a one-pole low-pass for high frequency damping
+(same filter as Onepole, but with the state and coefficients held as per line arrays so one loop updates every line; an array
+of Onepole objects doesn't vectorise across lines). The left input feeds the even lines and the right input the odd lines. The outputs are taken from the
+lines with alternating signs. Output is wet only.
+
+Processing is done in chunks no longer than the shortest line, so every line's reads for a chunk have already been written.
+Each line's chunk is read and written as a contiguous run. Per line state is stored as arrays (one entry per line), and the
+damping, mixing and output sums run over whole chunks or all lines at once so they vectorise.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_FractionalDelayLine.h"
+#include <math.h>
+#include <stddef.h>
+
+template<unsigned int num_lines, unsigned long max_line_length>
+class FdnReverb
+{
+public:
+
+    static_assert(num_lines >= 2 && (num_lines & (num_lines - 1)) == 0, "Number of lines must be a power of two");
+
+    enum class MixingMatrix
+    {
+        HADAMARD,
+        HOUSEHOLDER
+    };
+
+    static constexpr unsigned int BLOCK_CHUNK = 64;
+
+    FdnReverb()
+    {
+        setup(48000);
+        clear();
+    }
+
+    /*
+    Set the sample rate and default delay lengths (approximately 30 - 90ms).
+    */
+    void setup(int sample_rate)
+    {
+        m_sample_rate = sample_rate;
+        setDelayLengthsMs(30.0f, 90.0f);
+    }
+
+    /*
+    Set the range of delay line lengths, which sets the size of the room. Lengths are spread exponentially between the shortest
+    and longest and rounded to prime numbers of samples, so no two lines share a common factor. Limited to 1 sample -
+    max_line_length.
+    */
+    void setDelayLengthsMs(sample_t shortest_ms, sample_t longest_ms)
+    {
+        //At least one sample, so the exponential spread is never 0 * infinity
+        const sample_t one_sample_ms = 1000.0f / m_sample_rate;
+        shortest_ms = shortest_ms > one_sample_ms ? shortest_ms : one_sample_ms;
+        longest_ms = longest_ms > shortest_ms ? longest_ms : shortest_ms;
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            double position = static_cast<double>(line) / (num_lines - 1);
+            double length_ms = shortest_ms * pow(longest_ms / shortest_ms, position);
+            unsigned long length = nextPrime(static_cast<unsigned long>(length_ms * 0.001 * m_sample_rate));
+            while (length > max_line_length)
+            {
+                length = previousPrime(length - 1);
+            }
+            m_delay_lengths[line] = length;
+        }
+
+        m_chunk_length = BLOCK_CHUNK;
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            if (m_delay_lengths[line] < m_chunk_length)
+            {
+                m_chunk_length = static_cast<unsigned int>(m_delay_lengths[line]);
+            }
+        }
+        calcGains();
+    }
+
+    /*
+    Set the time taken for the reverb to decay by 60dB.
+    */
+    void setDecayTime(sample_t decay_time_seconds)
+    {
+        m_decay_time_seconds = decay_time_seconds > 0.001f ? decay_time_seconds : 0.001f;
+        calcGains();
+    }
+
+    /*
+    Set the high frequency damping, 0 (none) to 1 (maximum).
+    */
+    void setDamping(sample_t damping)
+    {
+        damping = auClamp(damping, 0.0f, 0.99f);
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            m_damping_b1[line] = -damping;
+        }
+        calcGains();
+    }
+
+    void setMixingMatrix(MixingMatrix mixing_matrix)
+    {
+        m_mixing_matrix = mixing_matrix;
+        calcGains();
+    }
+
+    /*
+    Process a stereo block (wet output only). Inputs and outputs can be the same buffers.
+    */
+    void processBlock(const sample_t* input_left, const sample_t* input_right, sample_t* output_left, sample_t* output_right,
+                      size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t chunk = (num_samples - i) < m_chunk_length ? (num_samples - i) : m_chunk_length;
+            processChunk(&input_left[i], &input_right[i], &output_left[i], &output_right[i], chunk);
+            i += chunk;
+        }
+    }
+
+    void clear()
+    {
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            for (unsigned long i = 0 ; i < Buffer::LENGTH ; i++)
+            {
+                m_lines[line][i] = 0;
+            }
+            m_damping_state[line] = 0;
+        }
+        m_write_index = 0;
+    }
+
+private:
+
+    typedef PowerOfTwoBuffer<max_line_length + 1> Buffer;
+
+    static bool isPrime(unsigned long value)
+    {
+        if (value < 2)
+        {
+            return false;
+        }
+        for (unsigned long divisor = 2 ; divisor * divisor <= value ; divisor++)
+        {
+            if (value % divisor == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static unsigned long nextPrime(unsigned long value)
+    {
+        while (!isPrime(value))
+        {
+            value++;
+        }
+        return value;
+    }
+
+    static unsigned long previousPrime(unsigned long value)
+    {
+        while (value > 2 && !isPrime(value))
+        {
+            value--;
+        }
+        return value;
+    }
+
+    void calcGains()
+    {
+        //Hadamard transform is unnormalised, its 1/sqrt(N) is folded into the line gains
+        sample_t matrix_scale = m_mixing_matrix == MixingMatrix::HADAMARD ? 1.0f / sqrtf(static_cast<sample_t>(num_lines)) : 1.0f;
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            //-60dB over the decay time: gain per pass = 10^(-3 * length / (decay time * sample rate))
+            double decay_gain = pow(10.0, -3.0 * m_delay_lengths[line] / (m_decay_time_seconds * m_sample_rate));
+            sample_t a0 = 1 - fabsf(m_damping_b1[line]);
+            m_line_gains[line] = static_cast<sample_t>(decay_gain) * a0 * matrix_scale;
+        }
+    }
+
+    void processChunk(const sample_t* input_left, const sample_t* input_right, sample_t* output_left, sample_t* output_right,
+                      size_t num_samples)
+    {
+        //Read each line's chunk (contiguous apart from a possible wrap)
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            unsigned long read_index = (m_write_index - m_delay_lengths[line]) & Buffer::MASK;
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                m_chunk[line][n] = m_lines[line][(read_index + n) & Buffer::MASK];
+            }
+        }
+
+        //Decay gain and damping (one-pole low-pass, as Onepole), across all lines per sample
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            for (unsigned int line = 0 ; line < num_lines ; line++)
+            {
+                m_damping_state[line] = (m_chunk[line][n] * m_line_gains[line]) - (m_damping_state[line] * m_damping_b1[line]);
+                m_chunk[line][n] = m_damping_state[line];
+            }
+        }
+
+        //Outputs, alternating signs so the two channels are decorrelated. Kept separate until the inputs have been used.
+        sample_t sum_left[BLOCK_CHUNK] = {};
+        sample_t sum_right[BLOCK_CHUNK] = {};
+        const sample_t output_gain = 2.0f / num_lines;
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            sample_t* sum = (line & 1) ? sum_right : sum_left;
+            sample_t gain = (line & 2) ? -output_gain : output_gain;
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                sum[n] += gain * m_chunk[line][n];
+            }
+        }
+
+        mix(num_samples);
+
+        //Add the input and write each line's chunk
+        for (unsigned int line = 0 ; line < num_lines ; line++)
+        {
+            const sample_t* input = (line & 1) ? input_right : input_left;
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                m_lines[line][(m_write_index + n) & Buffer::MASK] = m_chunk[line][n] + input[n];
+            }
+        }
+        m_write_index = (m_write_index + num_samples) & Buffer::MASK;
+
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            output_left[n] = sum_left[n];
+            output_right[n] = sum_right[n];
+        }
+    }
+
+    void mix(size_t num_samples)
+    {
+        if (m_mixing_matrix == MixingMatrix::HADAMARD)
+        {
+            for (unsigned int half = 1 ; half < num_lines ; half *= 2)
+            {
+                for (unsigned int start = 0 ; start < num_lines ; start += 2 * half)
+                {
+                    for (unsigned int line = start ; line < start + half ; line++)
+                    {
+                        sample_t* a = m_chunk[line];
+                        sample_t* b = m_chunk[line + half];
+                        for (size_t n = 0 ; n < num_samples ; n++)
+                        {
+                            sample_t sum = a[n] + b[n];
+                            b[n] = a[n] - b[n];
+                            a[n] = sum;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            sample_t sum[BLOCK_CHUNK] = {};
+            for (unsigned int line = 0 ; line < num_lines ; line++)
+            {
+                for (size_t n = 0 ; n < num_samples ; n++)
+                {
+                    sum[n] += m_chunk[line][n];
+                }
+            }
+            const sample_t scale = 2.0f / num_lines;
+            for (unsigned int line = 0 ; line < num_lines ; line++)
+            {
+                for (size_t n = 0 ; n < num_samples ; n++)
+                {
+                    m_chunk[line][n] -= scale * sum[n];
+                }
+            }
+        }
+    }
+
+    alignas(64) sample_t m_lines[num_lines][Buffer::LENGTH];
+    alignas(64) sample_t m_chunk[num_lines][BLOCK_CHUNK];
+    alignas(64) sample_t m_line_gains[num_lines] = {};
+    alignas(64) sample_t m_damping_b1[num_lines] = {};
+    alignas(64) sample_t m_damping_state[num_lines] = {};
+    unsigned long m_delay_lengths[num_lines] = {};
+    unsigned long m_write_index = 0;
+    unsigned int m_chunk_length = 1;
+
+    int m_sample_rate = 48000;
+    sample_t m_decay_time_seconds = 2.0f;
+    MixingMatrix m_mixing_matrix = MixingMatrix::HADAMARD;
+};
@@ -0,0 +1,206 @@
+/*
+
+au_FixedBiquad.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Biquad with the filter type fixed at compile time, for filters that never change (DC blockers, anti-alias filters, fixed shelves etc).
+Coefficients can be designed constexpr, and process() only does the arithmetic the filter type needs by using the
+relationships between coefficients, e.g. LOWPASS (a1 = 2*a0, a2 = a0) and BANDPASS (a1 = 0, a2 = -a0) need 3 multiplies rather than 5.
+Output matches Biquad to within float rounding (NOTCH and PEAK factor out a1 * (input - output), which is slightly more accurate at low cutoffs).
+
+Usage:
+    constexpr Biquad::Coefficients dc_block = FixedBiquad<Biquad::FilterType::HIGHPASS>::design(48000, 10, 0.7071);
+    FixedBiquad<Biquad::FilterType::HIGHPASS> dc_blocker(dc_block);
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_Biquad.h"
+#include <stddef.h>
+
+/*
+Compile time versions of the maths functions used for filter design. These are slower than libm at runtime, so are only intended for constexpr use.
+*/
+struct ConstexprMath
+{
+    static constexpr double sqrt(double x)
+    {
+        if (x <= 0)
+        {
+            return 0;
+        }
+        double estimate = x > 1 ? x : 1;
+        for (int i = 0 ; i < 100 ; i++)
+        {
+            double next_estimate = 0.5 * (estimate + x / estimate);
+            if (next_estimate == estimate)
+            {
+                break;
+            }
+            estimate = next_estimate;
+        }
+        return estimate;
+    }
+
+    static constexpr double exp(double x)
+    {
+        //Halve the argument until the Taylor series converges quickly, then square the result back up
+        int halvings = 0;
+        while (x > 0.5 || x < -0.5)
+        {
+            x *= 0.5;
+            halvings++;
+        }
+        double sum = 1;
+        double term = 1;
+        for (int n = 1 ; n < 20 ; n++)
+        {
+            term *= x / n;
+            sum += term;
+        }
+        for (int i = 0 ; i < halvings ; i++)
+        {
+            sum *= sum;
+        }
+        return sum;
+    }
+
+    //tan(x) for x in [0, PI/2)
+    static constexpr double tan(double x)
+    {
+        double x2 = x * x;
+        double sine = 0;
+        double cosine = 0;
+        double sine_term = x;
+        double cosine_term = 1;
+        for (int n = 0 ; n < 20 ; n++)
+        {
+            sine += sine_term;
+            cosine += cosine_term;
+            sine_term *= -x2 / ((2 * n + 2) * (2 * n + 3));
+            cosine_term *= -x2 / ((2 * n + 1) * (2 * n + 2));
+        }
+        return sine / cosine;
+    }
+
+    static constexpr double dBToLin(double db_value)
+    {
+        return exp(db_value * M_LN10 / 20.0);
+    }
+};
+
+template<Biquad::FilterType filter_type>
+class FixedBiquad
+{
+public:
+
+    /*
+    Design coefficients for this filter type. Can be evaluated at compile time.
+    Results match Biquad::designCoefficients() to within float rounding.
+    */
+    static constexpr Biquad::Coefficients design(sample_t sample_rate_hz, sample_t cutoff_freq_hz, sample_t quality_factor = M_SQRT1_2, sample_t filter_gain_db = 0)
+    {
+        Biquad::FilterSetup filter_setup = {sample_rate_hz, cutoff_freq_hz, quality_factor, filter_gain_db, filter_type};
+        double K = ConstexprMath::tan(M_PI * (cutoff_freq_hz / sample_rate_hz));
+        double V = ConstexprMath::dBToLin(filter_gain_db < 0 ? -filter_gain_db : filter_gain_db);
+        return Biquad::designFromPrewarpedCutoff(filter_setup, K, V, ConstexprMath::sqrt(2 * V));
+    }
+
+    constexpr FixedBiquad(Biquad::Coefficients biquad_coefficients) : m_coefficients(biquad_coefficients) {}
+
+    constexpr FixedBiquad(sample_t sample_rate_hz, sample_t cutoff_freq_hz, sample_t quality_factor = M_SQRT1_2, sample_t filter_gain_db = 0)
+        : m_coefficients(design(sample_rate_hz, cutoff_freq_hz, quality_factor, filter_gain_db)) {}
+
+    constexpr Biquad::Coefficients getCoefficients() const
+    {
+        return m_coefficients;
+    }
+
+    sample_t process(sample_t input_sample)
+    {
+        return processWithState(input_sample, m_z1, m_z2);
+    }
+
+    /*
+    Process a block of samples. Input and output can be the same buffer.
+    */
+    void processBlock(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        sample_t z1 = m_z1;
+        sample_t z2 = m_z2;
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = processWithState(input_buffer[i], z1, z2);
+        }
+        m_z1 = z1;
+        m_z2 = z2;
+    }
+
+    void clean()
+    {
+        m_z1 = 0;
+        m_z2 = 0;
+    }
+
+private:
+
+    inline sample_t processWithState(sample_t input_sample, sample_t& z1, sample_t& z2) const
+    {
+        const Biquad::Coefficients& c = m_coefficients;
+        sample_t output_sample;
+        switch (filter_type)
+        {
+        case Biquad::FilterType::LOWPASS: // a1 = 2*a0, a2 = a0
+        {
+            sample_t scaled_input = input_sample * c.a0;
+            output_sample = scaled_input + z1;
+            z1 = (2 * scaled_input) + z2 - (output_sample * c.b1);
+            z2 = scaled_input - (output_sample * c.b2);
+            break;
+        }
+        case Biquad::FilterType::HIGHPASS: // a1 = -2*a0, a2 = a0
+        {
+            sample_t scaled_input = input_sample * c.a0;
+            output_sample = scaled_input + z1;
+            z1 = z2 - (2 * scaled_input) - (output_sample * c.b1);
+            z2 = scaled_input - (output_sample * c.b2);
+            break;
+        }
+        case Biquad::FilterType::BANDPASS: // a1 = 0, a2 = -a0
+        {
+            sample_t scaled_input = input_sample * c.a0;
+            output_sample = scaled_input + z1;
+            z1 = z2 - (output_sample * c.b1);
+            z2 = -scaled_input - (output_sample * c.b2);
+            break;
+        }
+        case Biquad::FilterType::NOTCH: // a2 = a0, b1 = a1
+        {
+            sample_t scaled_input = input_sample * c.a0;
+            output_sample = scaled_input + z1;
+            z1 = ((input_sample - output_sample) * c.a1) + z2;
+            z2 = scaled_input - (output_sample * c.b2);
+            break;
+        }
+        case Biquad::FilterType::PEAK: // b1 = a1
+            output_sample = (input_sample * c.a0) + z1;
+            z1 = ((input_sample - output_sample) * c.a1) + z2;
+            z2 = (input_sample * c.a2) - (output_sample * c.b2);
+            break;
+        default: // Shelves use all 5 coefficients
+            output_sample = (input_sample * c.a0) + z1;
+            z1 = (input_sample * c.a1) + z2 - (output_sample * c.b1);
+            z2 = (input_sample * c.a2) - (output_sample * c.b2);
+            break;
+        }
+        return output_sample;
+    }
+
+    Biquad::Coefficients m_coefficients;
+    sample_t m_z1 = 0.0;
+    sample_t m_z2 = 0.0;
+};
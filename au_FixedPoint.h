@@ -0,0 +1,129 @@
+/*
+
+au_FixedPoint.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Saturating fixed point sample types for processors templated on sample type (e.g. BasicOnepole<Q15>).
+
+Q15 - 16 bit, 15 fractional bits, range -1.0 to 0.99997
+Q31 - 32 bit, 31 fractional bits, range -1.0 to 0.9999999995
+
+Arithmetic is done in the next wider integer type and saturates rather than wrapping, so an overload clips like an analogue
+stage instead of jumping to the opposite rail. Multiplies round to nearest. Values convert from float/double implicitly (rounded
+and saturated, so 1.0 becomes the largest positive value) and back to float/double explicitly.
+
+Only suitable for processors whose coefficients and state stay within -1 to 1.
+
+*/
+
+#pragma once
+
+#include "stdint.h"
+
+template<typename int_type, typename wide_type, int fractional_bits>
+class FixedPoint
+{
+public:
+
+    constexpr FixedPoint() : m_raw(0) {}
+
+    constexpr FixedPoint(double value) : m_raw(fromDouble(value)) {}
+
+    static constexpr FixedPoint fromRaw(int_type raw_value)
+    {
+        FixedPoint fixed_value;
+        fixed_value.m_raw = raw_value;
+        return fixed_value;
+    }
+
+    constexpr int_type getRaw() const
+    {
+        return m_raw;
+    }
+
+    explicit constexpr operator double() const
+    {
+        return m_raw / scale();
+    }
+
+    explicit constexpr operator float() const
+    {
+        return static_cast<float>(m_raw / scale());
+    }
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(saturate(static_cast<wide_type>(a.m_raw) + b.m_raw));
+    }
+
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b)
+    {
+        return fromRaw(saturate(static_cast<wide_type>(a.m_raw) - b.m_raw));
+    }
+
+    friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b)
+    {
+        wide_type product = static_cast<wide_type>(a.m_raw) * b.m_raw;
+        return fromRaw(saturate((product + (static_cast<wide_type>(1) << (fractional_bits - 1))) >> fractional_bits));
+    }
+
+    constexpr FixedPoint operator-() const
+    {
+        return fromRaw(saturate(-static_cast<wide_type>(m_raw)));
+    }
+
+    FixedPoint& operator+=(FixedPoint other)
+    {
+        *this = *this + other;
+        return *this;
+    }
+
+    FixedPoint& operator-=(FixedPoint other)
+    {
+        *this = *this - other;
+        return *this;
+    }
+
+    FixedPoint& operator*=(FixedPoint other)
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    friend constexpr bool operator==(FixedPoint a, FixedPoint b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(FixedPoint a, FixedPoint b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(FixedPoint a, FixedPoint b) { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator>(FixedPoint a, FixedPoint b) { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator<=(FixedPoint a, FixedPoint b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>=(FixedPoint a, FixedPoint b) { return a.m_raw >= b.m_raw; }
+
+private:
+
+    static constexpr wide_type MAX_RAW = (static_cast<wide_type>(1) << fractional_bits) - 1;
+    static constexpr wide_type MIN_RAW = -(static_cast<wide_type>(1) << fractional_bits);
+
+    static constexpr double scale()
+    {
+        return static_cast<double>(static_cast<wide_type>(1) << fractional_bits);
+    }
+
+    static constexpr int_type saturate(wide_type value)
+    {
+        return static_cast<int_type>(value > MAX_RAW ? MAX_RAW : (value < MIN_RAW ? MIN_RAW : value));
+    }
+
+    static constexpr int_type fromDouble(double value)
+    {
+        //Clamp before converting, so out of range values can't overflow wide_type
+        return value * scale() >= MAX_RAW ? static_cast<int_type>(MAX_RAW)
+             : value * scale() <= MIN_RAW ? static_cast<int_type>(MIN_RAW)
+             : static_cast<int_type>(static_cast<wide_type>(value * scale() + (value < 0 ? -0.5 : 0.5)));
+    }
+
+    int_type m_raw;
+};
+
+typedef FixedPoint<int16_t, int32_t, 15> Q15;
+typedef FixedPoint<int32_t, int64_t, 31> Q31;
@@ -0,0 +1,385 @@
+/*
+
+au_FractionalDelayLine.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Fractional delay line with a choice of interpolation, for modulated effects (chorus, flanger, pitch shifting) and physical models.
+
+Interpolation:
+LINEAR - 2 taps, cheapest. Low-pass effect that varies with the fractional delay. Minimum delay 0.
+CUBIC_LAGRANGE - 4 taps, 3rd order Lagrange. Much flatter response, best for modulated delays. Minimum delay 1.
+THIRAN_ALLPASS - 1st order Thiran allpass, flat magnitude response so doesn't damp feedback loops (e.g. string models).
+                 Recursive, so best suited to fixed or slowly changing delays. Minimum delay 0.5.
+
+Delays are in samples, between getMinDelay() and max_delay_samples. The delay can be changed immediately with setDelay(),
+ramped linearly with rampToDelay(), or modulated per sample by passing a buffer of delays to processBlock().
+
+processBlock() works in chunks of up to BLOCK_CHUNK samples: the whole chunk is written into the buffer, then all the read
+positions are calculated, then the interpolation runs over the chunk as one loop.
+
+For feedback structures (where the input depends on the output) use read() and write() per sample.
+
+FractionalInterpolation holds the interpolation kernels themselves. The other fractional delay readers in the library
+(KarplusStrong, KarplusStrongPool, MultiTapDelay) manage their own buffers, but use the same kernels.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include <stddef.h>
+
+/*
+Interpolation kernels shared by all fractional delay reads. Samples are passed in delay order, from the newest (at the whole
+part of the delay) to the oldest, and fraction is the fractional part of the delay. All are inline and branch free, so they
+vectorise when called across a block or across voices.
+*/
+struct FractionalInterpolation
+{
+    /*
+    Return: the value fraction (0 - 1) of the way from s0 to s1. Symmetric, so readers working forwards through the buffer can
+    pass the older sample first with the fraction measured from it.
+    */
+    static sample_t linear(sample_t s0, sample_t s1, sample_t fraction)
+    {
+        return s0 + (fraction * (s1 - s0));
+    }
+
+    /*
+    Weights for linear(), for readers that fold them into a fixed gain (s0 * s0_weight + s1 * s1_weight).
+    */
+    static void linearWeights(sample_t fraction, sample_t& s0_weight, sample_t& s1_weight)
+    {
+        s0_weight = 1.0f - fraction;
+        s1_weight = fraction;
+    }
+
+    /*
+    3rd order Lagrange through s_minus_1 (one sample newer than s0) to s2. Fraction 0 - 1.
+    */
+    static sample_t cubicLagrange(sample_t s_minus_1, sample_t s0, sample_t s1, sample_t s2, sample_t fraction)
+    {
+        sample_t f = fraction;
+        sample_t h_minus_1 = -f * (f - 1) * (f - 2) * (1.0f / 6.0f);
+        sample_t h_0 = (f + 1) * (f - 1) * (f - 2) * 0.5f;
+        sample_t h_1 = -(f + 1) * f * (f - 2) * 0.5f;
+        sample_t h_2 = (f + 1) * f * (f - 1) * (1.0f / 6.0f);
+        return (h_minus_1 * s_minus_1) + (h_0 * s0) + (h_1 * s1) + (h_2 * s2);
+    }
+
+    /*
+    1st order Thiran allpass. Fraction 0.5 - 1.5 for best accuracy. state is the previous output, and is updated.
+    */
+    static sample_t thiranAllpass(sample_t s0, sample_t s1, sample_t fraction, sample_t& state)
+    {
+        sample_t a = (1 - fraction) / (1 + fraction);
+        state = (a * s0) + s1 - (a * state);
+        return state;
+    }
+};
+
+/*
+Length of a delay buffer rounded up to a power of two (at least min_length), so indexes wrap with a mask.
+Shared by FractionalDelayLine, MultiTapDelay and FdnReverb.
+*/
+template<unsigned long min_length>
+struct PowerOfTwoBuffer
+{
+    static constexpr unsigned long nextPowerOfTwo(unsigned long value, unsigned long power = 1)
+    {
+        return power >= value ? power : nextPowerOfTwo(value, power * 2);
+    }
+
+    static constexpr unsigned long LENGTH = nextPowerOfTwo(min_length);
+    static constexpr unsigned long MASK = LENGTH - 1;
+};
+
+template<unsigned long max_delay_samples>
+class FractionalDelayLine
+{
+public:
+
+    enum class Interpolation
+    {
+        LINEAR,
+        CUBIC_LAGRANGE,
+        THIRAN_ALLPASS
+    };
+
+    static constexpr unsigned int BLOCK_CHUNK = 64;
+
+    FractionalDelayLine(Interpolation interpolation = Interpolation::LINEAR)
+    {
+        setInterpolation(interpolation);
+        clear();
+    }
+
+    void setInterpolation(Interpolation interpolation)
+    {
+        m_interpolation = interpolation;
+        m_allpass_state = 0;
+        setDelay(m_delay);
+    }
+
+    Interpolation getInterpolation()
+    {
+        return m_interpolation;
+    }
+
+    /*
+    Smallest delay supported by the current interpolation type.
+    */
+    sample_t getMinDelay()
+    {
+        switch (m_interpolation)
+        {
+        case Interpolation::CUBIC_LAGRANGE:
+            return 1.0f;
+        case Interpolation::THIRAN_ALLPASS:
+            return 0.5f;
+        default:
+            return 0.0f;
+        }
+    }
+
+    /*
+    Set the delay immediately, cancelling any ramp. Clamped to getMinDelay() - max_delay_samples.
+    */
+    void setDelay(sample_t delay_samples)
+    {
+        m_delay = clampDelay(delay_samples);
+        m_target_delay = m_delay;
+        m_ramp_samples_remaining = 0;
+    }
+
+    /*
+    Ramp the delay linearly to a new value over ramp_samples samples. A ramp of 0 samples sets the delay immediately.
+    */
+    void rampToDelay(sample_t delay_samples, unsigned int ramp_samples)
+    {
+        if (ramp_samples == 0)
+        {
+            setDelay(delay_samples);
+            return;
+        }
+        m_target_delay = clampDelay(delay_samples);
+        m_delay_increment = (m_target_delay - m_delay) / ramp_samples;
+        m_ramp_samples_remaining = ramp_samples;
+    }
+
+    sample_t getDelay()
+    {
+        return m_delay;
+    }
+
+    bool isRamping()
+    {
+        return m_ramp_samples_remaining > 0;
+    }
+
+    /*
+    Write a new sample and return the sample delayed by the current delay (following any ramp).
+    */
+    sample_t process(sample_t input_sample)
+    {
+        write(input_sample);
+        return read(nextDelay());
+    }
+
+    /*
+    Process a block using the current delay (following any ramp). Input and output can be the same buffer.
+    */
+    void processBlock(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        sample_t delays[BLOCK_CHUNK];
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t chunk = (num_samples - i) < BLOCK_CHUNK ? (num_samples - i) : BLOCK_CHUNK;
+            if (m_ramp_samples_remaining == 0)
+            {
+                for (size_t n = 0 ; n < chunk ; n++)
+                {
+                    delays[n] = m_delay;
+                }
+            }
+            else
+            {
+                for (size_t n = 0 ; n < chunk ; n++)
+                {
+                    delays[n] = nextDelay();
+                }
+            }
+            processChunk(&input_buffer[i], &output_buffer[i], delays, chunk);
+            i += chunk;
+        }
+    }
+
+    /*
+    Process a block with the delay modulated per sample. The delay set with setDelay()/rampToDelay() is not used or changed.
+
+    Parameters:
+    delay_buffer - delay in samples for each sample of the block (e.g. from an LFO), clamped to getMinDelay() - max_delay_samples
+    */
+    void processBlock(const sample_t* input_buffer, sample_t* output_buffer, const sample_t* delay_buffer, size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t chunk = (num_samples - i) < BLOCK_CHUNK ? (num_samples - i) : BLOCK_CHUNK;
+            processChunk(&input_buffer[i], &output_buffer[i], &delay_buffer[i], chunk);
+            i += chunk;
+        }
+    }
+
+    /*
+    Write a new sample into the delay line.
+    */
+    void write(sample_t input_sample)
+    {
+        m_buffer[m_write_index] = input_sample;
+        m_write_index = (m_write_index + 1) & Buffer::MASK;
+    }
+
+    /*
+    Read the delay line at a delay in samples behind the most recently written sample (0 is the most recent sample).
+    With THIRAN_ALLPASS the allpass state is updated, so read once per sample.
+    */
+    sample_t read(sample_t delay_samples)
+    {
+        return interpolate((m_write_index - 1) & Buffer::MASK, clampDelay(delay_samples));
+    }
+
+    void clear()
+    {
+        for (unsigned long i = 0 ; i < Buffer::LENGTH ; i++)
+        {
+            m_buffer[i] = 0;
+        }
+        m_write_index = 0;
+        m_allpass_state = 0;
+    }
+
+private:
+
+    //Room for the longest delay, the interpolation taps and a whole chunk written ahead of the reads
+    typedef PowerOfTwoBuffer<max_delay_samples + BLOCK_CHUNK + 4> Buffer;
+
+    sample_t clampDelay(sample_t delay_samples)
+    {
+        return auClamp(delay_samples, getMinDelay(), static_cast<sample_t>(max_delay_samples));
+    }
+
+    sample_t nextDelay()
+    {
+        if (m_ramp_samples_remaining > 0)
+        {
+            m_delay += m_delay_increment;
+            if (--m_ramp_samples_remaining == 0)
+            {
+                m_delay = m_target_delay;
+            }
+        }
+        return m_delay;
+    }
+
+    sample_t tap(unsigned long newest_index, long delay)
+    {
+        return m_buffer[(newest_index - delay) & Buffer::MASK];
+    }
+
+    sample_t interpolate(unsigned long newest_index, sample_t delay)
+    {
+        switch (m_interpolation)
+        {
+        case Interpolation::CUBIC_LAGRANGE:
+        {
+            long whole = static_cast<long>(delay);
+            return FractionalInterpolation::cubicLagrange(tap(newest_index, whole - 1), tap(newest_index, whole),
+                                                          tap(newest_index, whole + 1), tap(newest_index, whole + 2), delay - whole);
+        }
+        case Interpolation::THIRAN_ALLPASS:
+        {
+            //Fractional part kept in 0.5 - 1.5, where the allpass delay is most accurate
+            long whole = static_cast<long>(delay - 0.5f);
+            return FractionalInterpolation::thiranAllpass(tap(newest_index, whole), tap(newest_index, whole + 1), delay - whole,
+                                                          m_allpass_state);
+        }
+        default:
+        {
+            long whole = static_cast<long>(delay);
+            return FractionalInterpolation::linear(tap(newest_index, whole), tap(newest_index, whole + 1), delay - whole);
+        }
+        }
+    }
+
+    void processChunk(const sample_t* input_buffer, sample_t* output_buffer, const sample_t* delays, size_t num_samples)
+    {
+        //Whole chunk is written first, so reads never need a sample that isn't in the buffer yet
+        unsigned long first_index = m_write_index;
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            m_buffer[(first_index + n) & Buffer::MASK] = input_buffer[n];
+        }
+        m_write_index = (first_index + num_samples) & Buffer::MASK;
+
+        //Read positions for the whole chunk
+        const sample_t min_delay = getMinDelay();
+        const sample_t max_delay = static_cast<sample_t>(max_delay_samples);
+        long whole[BLOCK_CHUNK];
+        sample_t fraction[BLOCK_CHUNK];
+        const sample_t whole_offset = m_interpolation == Interpolation::THIRAN_ALLPASS ? 0.5f : 0.0f;
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            sample_t delay = delays[n] < min_delay ? min_delay : (delays[n] > max_delay ? max_delay : delays[n]);
+            whole[n] = static_cast<long>(delay - whole_offset);
+            fraction[n] = delay - whole[n];
+        }
+
+        switch (m_interpolation)
+        {
+        case Interpolation::CUBIC_LAGRANGE:
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                unsigned long index = first_index + n - whole[n];
+                output_buffer[n] = FractionalInterpolation::cubicLagrange(m_buffer[(index + 1) & Buffer::MASK],
+                                                                          m_buffer[index & Buffer::MASK],
+                                                                          m_buffer[(index - 1) & Buffer::MASK],
+                                                                          m_buffer[(index - 2) & Buffer::MASK], fraction[n]);
+            }
+            break;
+        case Interpolation::THIRAN_ALLPASS:
+        {
+            sample_t state = m_allpass_state;
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                unsigned long index = first_index + n - whole[n];
+                output_buffer[n] = FractionalInterpolation::thiranAllpass(m_buffer[index & Buffer::MASK],
+                                                                          m_buffer[(index - 1) & Buffer::MASK], fraction[n], state);
+            }
+            m_allpass_state = state;
+            break;
+        }
+        default:
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                unsigned long index = first_index + n - whole[n];
+                output_buffer[n] = FractionalInterpolation::linear(m_buffer[index & Buffer::MASK],
+                                                                   m_buffer[(index - 1) & Buffer::MASK], fraction[n]);
+            }
+            break;
+        }
+    }
+
+    sample_t m_buffer[Buffer::LENGTH];
+    unsigned long m_write_index = 0;
+
+    Interpolation m_interpolation = Interpolation::LINEAR;
+    sample_t m_delay = 0;
+    sample_t m_target_delay = 0;
+    sample_t m_delay_increment = 0;
+    unsigned int m_ramp_samples_remaining = 0;
+    sample_t m_allpass_state = 0;
+};
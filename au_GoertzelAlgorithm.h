@@ -8,10 +8,16 @@
 #pragma once
 
 #include "au_config.h"
+#include "au_Denormals.h"
 #include "math.h"
 
 
-class GoertzelAlgorithm
+/*
+Templated on sample type: GoertzelAlgorithm (float) or BasicGoertzelAlgorithm<double> for long windows, where float
+accumulation of the Q values loses precision.
+*/
+template<typename sample_type>
+class BasicGoertzelAlgorithm
 {
 public:
 
@@ -19,39 +25,44 @@ public:
     {
         int sample_rate;
         int window_size_periods = 1;
-        sample_t target_frequency;
+        sample_type target_frequency;
     };
 
 
     struct QValues
     {
-        sample_t q1 = 0;
-        sample_t q2 = 0;
+        sample_type q1 = 0;
+        sample_type q2 = 0;
         void reset()
         {
             q1 = 0;
             q2 = 0;
         }
+        void flushDenormals()
+        {
+            q1 = flushDenormal(q1);
+            q2 = flushDenormal(q2);
+        }
     };
 
     void setup(const SetupParameters& setup_parameters);
     /*
      * Returns actual frequency (integer length of window causes rounding)
      */
-    sample_t setTargetFrequencyHz(sample_t target_frequency_hz);
+    sample_type setTargetFrequencyHz(sample_type target_frequency_hz);
     void setWindowSizePeriods(int window_size_periods);
-    void process(sample_t new_sample, QValues& q_vals);
+    void process(sample_type new_sample, QValues& q_vals);
 
     int getWindowLengthSamples();
     int getWindowLengthPeriods();
     
 
-    sample_t getMagnitudeQuick(QValues q_vals);
+    sample_type getMagnitudeQuick(QValues q_vals);
 
     struct ComplexPolarForm
     {
-        sample_t magnitude;
-        sample_t phase;
+        sample_type magnitude;
+        sample_type phase;
     };
 
     ComplexPolarForm getComplexMagnitudeAndPhase(QValues q_vals);
@@ -61,25 +72,29 @@ public:
     int m_window_size_periods = 1;
 
 private:
-    sample_t m_coefficient;
-    sample_t m_sine_of_omega;
-    sample_t m_cosine_of_omega;
+    sample_type m_coefficient;
+    sample_type m_sine_of_omega;
+    sample_type m_cosine_of_omega;
 
-    sample_t m_target_frequency;
+    sample_type m_target_frequency;
     int m_sample_rate;
 
     //Returns actual frequency achieved with integer window
-    sample_t recalcCoefficients();
+    sample_type recalcCoefficients();
 };
 
 /*
 For use in realtime environments, this class updates the Q values sample by sample, rather than bulk processing at the end of each window
 */
-class RealtimeGoertzel : public GoertzelAlgorithm
+template<typename sample_type>
+class BasicRealtimeGoertzel : public BasicGoertzelAlgorithm<sample_type>
 {
 public:
 
-    void processSample(sample_t new_sample);
+    typedef typename BasicGoertzelAlgorithm<sample_type>::QValues QValues;
+    typedef typename BasicGoertzelAlgorithm<sample_type>::ComplexPolarForm ComplexPolarForm;
+
+    void processSample(sample_type new_sample);
 
     /*
     Virtual function called when the end of the window is reached, allowing program to get magnitude/phase without continuously polling for new value
@@ -89,9 +104,9 @@ public:
     /*
     Get the magnitude of the last complete window
     */
-    sample_t getLastMagnitude();
+    sample_type getLastMagnitude();
 
-    sample_t getLastPhase();
+    sample_type getLastPhase();
 
     /*
     Get the magnitude and phase of the last complete window
@@ -100,6 +115,12 @@ public:
 
     void reset();
 
+    /*
+    Zero Q values that are below DENORMAL_FLUSH_THRESHOLD. Call once per block to keep them out of the denormal range when the
+    input is silent (see au_Denormals.h).
+    */
+    void flushDenormals();
+
     /*
      * Returns true if a new window val is available since last flag check, false if not
      */
@@ -116,25 +137,35 @@ private:
 /*
 This class takes the whole window as a buffer and processes it in one go.
 */
-class WholeWindowGoertzel : public GoertzelAlgorithm
+template<typename sample_type>
+class BasicWholeWindowGoertzel : public BasicGoertzelAlgorithm<sample_type>
 {
 public:
-    
-    double getMagnitude(double* window_buffer)
+
+    typedef typename BasicGoertzelAlgorithm<sample_type>::QValues QValues;
+    typedef typename BasicGoertzelAlgorithm<sample_type>::ComplexPolarForm ComplexPolarForm;
+
+    /*
+    Buffers can be sample_type, float, double or any type convertible to sample_type, so no conversion copy is needed.
+    */
+    template<typename T>
+    double getMagnitude(const T* window_buffer)
     {
-        return getMagnitudeQuick(getQValsForBuffer(window_buffer));
+        return this->getMagnitudeQuick(getQValsForBuffer(window_buffer));
     }
-    ComplexPolarForm getMagnitudeAndPhase(double* window_buffer)
+    template<typename T>
+    ComplexPolarForm getMagnitudeAndPhase(const T* window_buffer)
     {
-        return getComplexMagnitudeAndPhase(getQValsForBuffer(window_buffer));
+        return this->getComplexMagnitudeAndPhase(getQValsForBuffer(window_buffer));
     }
 private:
-    QValues getQValsForBuffer(double* buffer)
+    template<typename T>
+    QValues getQValsForBuffer(const T* buffer)
     {
         QValues q_vals;
-        for (int i = 0 ; i < m_window_length_samples ; i++)
+        for (int i = 0 ; i < this->m_window_length_samples ; i++)
         {
-            process(buffer[i], q_vals);
+            this->process(buffer[i], q_vals);
         }
 
         return q_vals;
@@ -142,31 +173,9 @@ private:
 
 };
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+typedef BasicGoertzelAlgorithm<sample_t> GoertzelAlgorithm;
+typedef BasicRealtimeGoertzel<sample_t> RealtimeGoertzel;
+typedef BasicWholeWindowGoertzel<sample_t> WholeWindowGoertzel;
 
 
 
@@ -174,7 +183,8 @@ private:
  * GoertzelAlgorithm implementation
  */
 
-void GoertzelAlgorithm::setup(const SetupParameters& setup_parameters)
+template<typename sample_type>
+void BasicGoertzelAlgorithm<sample_type>::setup(const SetupParameters& setup_parameters)
 {
     m_sample_rate = setup_parameters.sample_rate;
     m_window_size_periods = setup_parameters.window_size_periods;
@@ -182,58 +192,66 @@ void GoertzelAlgorithm::setup(const SetupParameters& setup_parameters)
     recalcCoefficients();
 }
 
-sample_t GoertzelAlgorithm::setTargetFrequencyHz(sample_t target_frequency_hz)
+template<typename sample_type>
+sample_type BasicGoertzelAlgorithm<sample_type>::setTargetFrequencyHz(sample_type target_frequency_hz)
 {
     m_target_frequency = target_frequency_hz;
     return recalcCoefficients();
 }
 
-void GoertzelAlgorithm::process(sample_t new_sample, QValues& q_vals)
+template<typename sample_type>
+void BasicGoertzelAlgorithm<sample_type>::process(sample_type new_sample, QValues& q_vals)
 {
-    sample_t q0 = new_sample + (m_coefficient * q_vals.q1) - q_vals.q2;
+    sample_type q0 = new_sample + (m_coefficient * q_vals.q1) - q_vals.q2;
     q_vals.q2 = q_vals.q1;
     q_vals.q1 = q0;
 }
 
-int GoertzelAlgorithm::getWindowLengthSamples()
+template<typename sample_type>
+int BasicGoertzelAlgorithm<sample_type>::getWindowLengthSamples()
 {
     return m_window_length_samples;
 }
 
-sample_t GoertzelAlgorithm::getMagnitudeQuick(QValues q_vals)
+template<typename sample_type>
+sample_type BasicGoertzelAlgorithm<sample_type>::getMagnitudeQuick(QValues q_vals)
 {
     return sqrt( (q_vals.q1 * q_vals.q1) + (q_vals.q2 * q_vals.q2) - (m_coefficient * q_vals.q1 * q_vals.q2));
 }
 
-GoertzelAlgorithm::ComplexPolarForm GoertzelAlgorithm::getComplexMagnitudeAndPhase(QValues q_vals)
+template<typename sample_type>
+typename BasicGoertzelAlgorithm<sample_type>::ComplexPolarForm BasicGoertzelAlgorithm<sample_type>::getComplexMagnitudeAndPhase(QValues q_vals)
 {
     ComplexPolarForm mag_and_phase;
-    sample_t real = q_vals.q1 - (q_vals.q2 * m_cosine_of_omega);
-    sample_t imaginary = q_vals.q2 * m_sine_of_omega;
+    sample_type real = q_vals.q1 - (q_vals.q2 * m_cosine_of_omega);
+    sample_type imaginary = q_vals.q2 * m_sine_of_omega;
     mag_and_phase.magnitude = sqrt( (real * real) + (imaginary * imaginary));
     mag_and_phase.phase = atan(imaginary / real);
     return mag_and_phase;
 }
 
-sample_t GoertzelAlgorithm::recalcCoefficients()
+template<typename sample_type>
+sample_type BasicGoertzelAlgorithm<sample_type>::recalcCoefficients()
 {
-    sample_t omega = (2.0 * M_PI * m_target_frequency) / m_sample_rate;
+    sample_type omega = (2.0 * M_PI * m_target_frequency) / m_sample_rate;
     m_coefficient = 2.0 * cos(omega);
     m_sine_of_omega = sin(omega);
     m_cosine_of_omega = cos(omega);
 
     int target_period_rounded = static_cast<int>(m_sample_rate / m_target_frequency);
     m_window_length_samples = m_window_size_periods * (m_sample_rate / m_target_frequency);
-    return static_cast<sample_t>( m_sample_rate / target_period_rounded);
+    return static_cast<sample_type>( m_sample_rate / target_period_rounded);
 }
 
-void GoertzelAlgorithm::setWindowSizePeriods(int window_size_periods)
+template<typename sample_type>
+void BasicGoertzelAlgorithm<sample_type>::setWindowSizePeriods(int window_size_periods)
 {
     m_window_size_periods = window_size_periods;
     recalcCoefficients();
 }
 
-int GoertzelAlgorithm::getWindowLengthPeriods()
+template<typename sample_type>
+int BasicGoertzelAlgorithm<sample_type>::getWindowLengthPeriods()
 {
     return m_window_size_periods;
 }
@@ -243,10 +261,11 @@ int GoertzelAlgorithm::getWindowLengthPeriods()
  * RealtimeGoertzel implementation
  */
 
-void RealtimeGoertzel::processSample(sample_t new_sample)
+template<typename sample_type>
+void BasicRealtimeGoertzel<sample_type>::processSample(sample_type new_sample)
 {
-    process(new_sample, m_current_q_values);
-    if (++m_samples_in_window_processed == m_window_length_samples)
+    this->process(new_sample, m_current_q_values);
+    if (++m_samples_in_window_processed == this->m_window_length_samples)
     {
         m_last_q_values = m_current_q_values;
         reset();
@@ -254,29 +273,40 @@ void RealtimeGoertzel::processSample(sample_t new_sample)
     }
 }
 
-sample_t RealtimeGoertzel::getLastMagnitude()
+template<typename sample_type>
+sample_type BasicRealtimeGoertzel<sample_type>::getLastMagnitude()
 {
-    return getMagnitudeQuick(m_last_q_values);
+    return this->getMagnitudeQuick(m_last_q_values);
 }
 
-sample_t RealtimeGoertzel::getLastPhase()
+template<typename sample_type>
+sample_type BasicRealtimeGoertzel<sample_type>::getLastPhase()
 {
-    GoertzelAlgorithm::ComplexPolarForm mag_and_phase = getComplexMagnitudeAndPhase(m_last_q_values);
+    ComplexPolarForm mag_and_phase = this->getComplexMagnitudeAndPhase(m_last_q_values);
     return mag_and_phase.phase;
 }
 
-GoertzelAlgorithm::ComplexPolarForm RealtimeGoertzel::getLastComplexMagnitudeAndPhase()
+template<typename sample_type>
+typename BasicRealtimeGoertzel<sample_type>::ComplexPolarForm BasicRealtimeGoertzel<sample_type>::getLastComplexMagnitudeAndPhase()
 {
-    return getComplexMagnitudeAndPhase(m_last_q_values);
+    return this->getComplexMagnitudeAndPhase(m_last_q_values);
 }
 
-void RealtimeGoertzel::reset()
+template<typename sample_type>
+void BasicRealtimeGoertzel<sample_type>::reset()
 {
     m_current_q_values.reset();
     m_samples_in_window_processed = 0;
 }
 
-bool RealtimeGoertzel::checkNewValFlag()
+template<typename sample_type>
+void BasicRealtimeGoertzel<sample_type>::flushDenormals()
+{
+    m_current_q_values.flushDenormals();
+}
+
+template<typename sample_type>
+bool BasicRealtimeGoertzel<sample_type>::checkNewValFlag()
 {
     bool flag_state = m_new_val_flag;
     m_new_val_flag = false;
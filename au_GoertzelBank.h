@@ -0,0 +1,257 @@
+/*
+
+au_GoertzelBank.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Runs the Goertzel algorithm for several target frequencies (bins) over the same input, e.g. for DTMF or pilot tone detection.
+Coefficients and Q values for all bins are stored in structure-of-arrays layout, so each input sample is read once and
+the recurrence for every bin is updated in one loop that the compiler vectorises (one SIMD lane per bin).
+
+All bins share one window length. As with RealtimeGoertzel, results are latched at the end of each window.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_GoertzelAlgorithm.h"
+#include <math.h>
+#include <stddef.h>
+
+template<unsigned int max_bins>
+class GoertzelBank
+{
+public:
+
+    GoertzelBank()
+    {
+        for (unsigned int bin = 0 ; bin < max_bins ; bin++)
+        {
+            m_target_frequency[bin] = 0;
+            m_coefficient[bin] = 0;
+            m_sine_of_omega[bin] = 0;
+            m_cosine_of_omega[bin] = 0;
+            m_last_q1[bin] = 0;
+            m_last_q2[bin] = 0;
+        }
+        reset();
+    }
+
+    /*
+    Set the sample rate and window length. Coefficients for any frequencies already set are recalculated for the new rate.
+
+    Return: false (and no change) if the sample rate or window length is not positive
+    */
+    bool setup(int sample_rate, int window_length_samples)
+    {
+        if (sample_rate <= 0 || window_length_samples <= 0)
+        {
+            return false;
+        }
+        m_sample_rate = sample_rate;
+        m_window_length_samples = window_length_samples;
+        for (unsigned int bin = 0 ; bin < m_num_bins ; bin++)
+        {
+            calcBinCoefficients(bin);
+        }
+        reset();
+        return true;
+    }
+
+    /*
+    Return: false (and no change) if window_length_samples is not positive
+    */
+    bool setWindowLengthSamples(int window_length_samples)
+    {
+        if (window_length_samples <= 0)
+        {
+            return false;
+        }
+        m_window_length_samples = window_length_samples;
+        reset();
+        return true;
+    }
+
+    int getWindowLengthSamples()
+    {
+        return m_window_length_samples;
+    }
+
+    /*
+    Set the target frequencies of the bank. Bins above num_bins (up to max_bins) are disabled.
+    */
+    void setTargetFrequencies(const sample_t* target_frequencies_hz, unsigned int num_bins)
+    {
+        m_num_bins = num_bins > max_bins ? max_bins : num_bins;
+        for (unsigned int bin = 0 ; bin < max_bins ; bin++)
+        {
+            if (bin < m_num_bins)
+            {
+                setBinFrequency(bin, target_frequencies_hz[bin]);
+            }
+            else
+            {
+                m_target_frequency[bin] = 0;
+                m_coefficient[bin] = 0;
+            }
+        }
+        reset();
+    }
+
+    /*
+    Set one bin's target frequency. The frequency is kept, so it can be set before setup() or the sample rate changed later.
+    */
+    void setBinFrequency(unsigned int bin, sample_t target_frequency_hz)
+    {
+        if (bin >= max_bins)
+        {
+            return;
+        }
+        m_target_frequency[bin] = target_frequency_hz;
+        calcBinCoefficients(bin);
+    }
+
+    unsigned int getNumBins()
+    {
+        return m_num_bins;
+    }
+
+    /*
+    Update every bin with a new sample.
+    All max_bins lanes are updated (disabled bins have a coefficient of 0) so the loop has a fixed trip count.
+    */
+    void processSample(sample_t new_sample)
+    {
+        updateBins(new_sample);
+        if (++m_samples_in_window_processed == m_window_length_samples)
+        {
+            endWindow();
+        }
+    }
+
+    /*
+    Update every bin with a block of samples. Windows can start and end anywhere within the block, but only the
+    last completed window in the block is available afterwards.
+    */
+    void processBlock(const sample_t* buffer, size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t samples_to_window_end = m_window_length_samples - m_samples_in_window_processed;
+            size_t samples_to_process = (num_samples - i) < samples_to_window_end ? (num_samples - i) : samples_to_window_end;
+            for (size_t n = 0 ; n < samples_to_process ; n++)
+            {
+                updateBins(buffer[i + n]);
+            }
+            i += samples_to_process;
+            m_samples_in_window_processed += samples_to_process;
+            if (m_samples_in_window_processed == m_window_length_samples)
+            {
+                endWindow();
+            }
+        }
+    }
+
+    /*
+    Get the magnitude of every bin for the last complete window.
+
+    Parameters:
+    magnitudes - buffer of at least getNumBins() values
+    */
+    void getLastMagnitudes(sample_t* magnitudes)
+    {
+        for (unsigned int bin = 0 ; bin < m_num_bins ; bin++)
+        {
+            sample_t q1 = m_last_q1[bin];
+            sample_t q2 = m_last_q2[bin];
+            magnitudes[bin] = sqrt((q1 * q1) + (q2 * q2) - (m_coefficient[bin] * q1 * q2));
+        }
+    }
+
+    /*
+    Get the magnitude and phase of every bin for the last complete window.
+
+    Parameters:
+    mag_and_phase - buffer of at least getNumBins() values
+    */
+    void getLastComplexMagnitudesAndPhases(GoertzelAlgorithm::ComplexPolarForm* mag_and_phase)
+    {
+        for (unsigned int bin = 0 ; bin < m_num_bins ; bin++)
+        {
+            sample_t real = m_last_q1[bin] - (m_last_q2[bin] * m_cosine_of_omega[bin]);
+            sample_t imaginary = m_last_q2[bin] * m_sine_of_omega[bin];
+            mag_and_phase[bin].magnitude = sqrt((real * real) + (imaginary * imaginary));
+            mag_and_phase[bin].phase = atan(imaginary / real);
+        }
+    }
+
+    /*
+     * Returns true if a new window val is available since last flag check, false if not
+     */
+    bool checkNewValFlag()
+    {
+        bool flag_state = m_new_val_flag;
+        m_new_val_flag = false;
+        return flag_state;
+    }
+
+    void reset()
+    {
+        for (unsigned int bin = 0 ; bin < max_bins ; bin++)
+        {
+            m_q1[bin] = 0;
+            m_q2[bin] = 0;
+        }
+        m_samples_in_window_processed = 0;
+    }
+
+private:
+
+    void calcBinCoefficients(unsigned int bin)
+    {
+        sample_t omega = (2.0 * M_PI * m_target_frequency[bin]) / m_sample_rate;
+        m_coefficient[bin] = 2.0 * cos(omega);
+        m_sine_of_omega[bin] = sin(omega);
+        m_cosine_of_omega[bin] = cos(omega);
+    }
+
+    inline void updateBins(sample_t new_sample)
+    {
+        for (unsigned int bin = 0 ; bin < max_bins ; bin++)
+        {
+            sample_t q0 = new_sample + (m_coefficient[bin] * m_q1[bin]) - m_q2[bin];
+            m_q2[bin] = m_q1[bin];
+            m_q1[bin] = q0;
+        }
+    }
+
+    void endWindow()
+    {
+        for (unsigned int bin = 0 ; bin < max_bins ; bin++)
+        {
+            m_last_q1[bin] = m_q1[bin];
+            m_last_q2[bin] = m_q2[bin];
+        }
+        reset();
+        m_new_val_flag = true;
+    }
+
+    alignas(64) sample_t m_coefficient[max_bins];
+    alignas(64) sample_t m_q1[max_bins];
+    alignas(64) sample_t m_q2[max_bins];
+
+    sample_t m_target_frequency[max_bins];
+    sample_t m_sine_of_omega[max_bins];
+    sample_t m_cosine_of_omega[max_bins];
+    sample_t m_last_q1[max_bins];
+    sample_t m_last_q2[max_bins];
+
+    unsigned int m_num_bins = 0;
+    int m_sample_rate = 1;
+    int m_window_length_samples = 1;
+    int m_samples_in_window_processed = 0;
+    bool m_new_val_flag = false;
+};
@@ -5,14 +5,26 @@ au_KarplusStrong.h
 Author: Matt Davison
 Date: 25/04/2025
 
+Karplus-Strong plucked string/drum voice. The sample rate is set at construction, which also sizes the delay buffer from the
+lowest fundamental (so construct outside of the audio thread). See KarplusStrongPool for many voices.
+
+After a pluck or a pitch change the delay length slews to its target by 1% of the remaining distance per sample. The slew is
+kept per sample (rather than stepped once per block) so output doesn't depend on block size, and the read position moves every
+sample while slewing anyway. processBlock() only runs it until it settles on the target, and skips it from then on. At 48kHz
+that is up to about 900 samples after a pluck and 950-1250 after a pitch change.
+
 */
 
 #pragma once
 
-#define SAMPLE_RATE 48000
-
 #include "stdint.h"
 #include "au_config.h"
+#include "au_Denormals.h"
+#include "au_Noise.h"
+#include "au_FractionalDelayLine.h"
+#include <math.h>
+#include <stddef.h>
+#include <vector>
 
 namespace AudioUtils
 {
@@ -21,26 +33,29 @@ namespace AudioUtils
     public:
 
         static constexpr float LOWEST_FUNDAMENTAL_HZ = 20.0;
-        static constexpr int MAX_DELAY = static_cast<int>(SAMPLE_RATE / LOWEST_FUNDAMENTAL_HZ);
-        static constexpr int BUFFER_SIZE = MAX_DELAY + 2;
 
-        KarplusStrong() 
+        KarplusStrong(int sample_rate = 48000, sample_t lowest_fundamental_hz = LOWEST_FUNDAMENTAL_HZ)
         {
+            sampleRate = sample_rate;
+            lowestFundamental = lowest_fundamental_hz;
+            bufferSize = static_cast<int>(sampleRate / lowestFundamental) + 2;
+            buffer.assign(bufferSize, 0.0f);
             damping = 0.98f;
             blend = 0.9f;
             lowpassCoeff = 0.5f;
             pluckPos = 0.2f;
             writeIndex = 0;
-            delayLength = 200.0f;
-            targetDelay = 200.0f;
-            for (int i = 0; i < BUFFER_SIZE; ++i) buffer[i] = 0.0f;
+            flushIndex = 0;
+            unflushedSamples = 0;
+            setFrequency(440.0f); //Clamped to what the buffer can hold
+            delayLength = targetDelay;
+            lowpassState = 0.0f;
         }
     
         void setFrequency(sample_t freq) 
         {
-            if (freq < 20.0f) freq = 20.0f;
-            freq = auClamp(freq, LOWEST_FUNDAMENTAL_HZ, SAMPLE_RATE / 2 ); //Clamp between delay line length and Nyquist
-            targetDelay = SAMPLE_RATE / freq;
+            freq = auClamp(freq, lowestFundamental, sampleRate / 2 ); //Clamp between delay line length and Nyquist
+            targetDelay = sampleRate / freq;
         }
     
         void setDamping(sample_t d) { damping = auClamp(d, 0.0f, 1.0f); }
@@ -50,39 +65,117 @@ namespace AudioUtils
 
         sample_t getDamping(){return damping;}
         sample_t getBlend(){return blend;}
-        sample_t getFrequency(){return SAMPLE_RATE / targetDelay;}
+        sample_t getFrequency(){return sampleRate / targetDelay;}
+        int getSampleRate(){return sampleRate;}
     
         void pluck() 
         {
             int len = static_cast<int>(targetDelay);
             delayLength = static_cast<float>(len);
-            for (int i = 0; i < len; ++i) buffer[i] = fastRand();
+            noise.white(buffer.data(), len);
     
             int M = static_cast<int>(pluckPos * len);
             for (int i = M; i < len; ++i) {
                 buffer[i] -= buffer[i - M];
             }
-            writeIndex = len % BUFFER_SIZE;
+            writeIndex = len % bufferSize;
+            unflushedSamples = bufferSize; //Write point has jumped, so the next flush covers the whole line
             lowpassState = 0.0f;
         }
     
         sample_t process(sample_t input = 0.0f) 
         {
-            // Change delay length gradually to avoid artefacts during plucks
-            sample_t slew = 0.01f;
-            delayLength += slew * (targetDelay - delayLength);
+            unflushedSamples++;
+            slewDelay();
+            return tick(input);
+        }
+
+        /*
+        Process a block. Output is identical to calling process() for each sample. The per sample delay length slew still runs
+        while the delay is moving (see top of file), but is skipped once it has settled, and buffer wrapping uses compares rather
+        than modulos.
+
+        Parameters:
+        input_buffer - excitation added into the string, or nullptr for none
+        */
+        void processBlock(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+        {
+            unflushedSamples += num_samples;
+            size_t i = 0;
+            for ( ; i < num_samples && delayLength != targetDelay ; i++)
+            {
+                slewDelay();
+                output_buffer[i] = tick(input_buffer != nullptr ? input_buffer[i] : 0.0f);
+            }
+            for ( ; i < num_samples ; i++)
+            {
+                output_buffer[i] = tick(input_buffer != nullptr ? input_buffer[i] : 0.0f);
+            }
+        }
+
+        /*
+        Zero string state (lowpass state and the delay line written since the last call) that has decayed below
+        DENORMAL_FLUSH_THRESHOLD. Call once per block to keep a ringing out string from reaching denormals (see
+        au_Denormals.h). Costs one compare per sample processed since the last call, up to the whole delay line (bufferSize)
+        if more than that has been processed, or after a pluck.
+        */
+        void flushDenormals()
+        {
+            lowpassState = flushDenormal(lowpassState);
+            if (unflushedSamples >= static_cast<size_t>(bufferSize))
+            {
+                sample_t* data = buffer.data();
+                for (int i = 0 ; i < bufferSize ; i++)
+                {
+                    data[i] = flushDenormal(data[i]);
+                }
+                flushIndex = writeIndex;
+                unflushedSamples = 0;
+                return;
+            }
+            int end = writeIndex < flushIndex ? bufferSize : writeIndex;
+            for (int i = flushIndex ; i < end ; i++)
+            {
+                buffer[i] = flushDenormal(buffer[i]);
+            }
+            if (writeIndex < flushIndex)
+            {
+                for (int i = 0 ; i < writeIndex ; i++)
+                {
+                    buffer[i] = flushDenormal(buffer[i]);
+                }
+            }
+            flushIndex = writeIndex;
+            unflushedSamples = 0;
+        }
     
+    private:
+
+        void slewDelay()
+        {
+            // Change delay length gradually to avoid artefacts during plucks, snapping to the target once it has settled. In float
+            // the step stops changing delayLength before it is within 1e-4 for most pitches (e.g. 3.8e-4 samples short at 440Hz,
+            // 6.1e-3 at 27.5Hz), so also snap once a step makes no progress.
+            sample_t slew = 0.01f;
+            sample_t next = delayLength + (slew * (targetDelay - delayLength));
+            if (next == delayLength || fabsf(targetDelay - next) < 1e-4f) next = targetDelay;
+            delayLength = next;
+        }
+
+        sample_t tick(sample_t input)
+        {
             sample_t readIndex = writeIndex - delayLength;
-            if (readIndex < 0) readIndex += BUFFER_SIZE;
+            if (readIndex < 0) readIndex += bufferSize;
             
             // Linear interpolation for non-integer read indexes
             int i1 = static_cast<int>(readIndex);
-            int i2 = (i1 + 1) % BUFFER_SIZE;
+            int i2 = i1 + 1;
+            if (i2 >= bufferSize) i2 -= bufferSize;
             sample_t frac = readIndex - static_cast<float>(i1);
-            sample_t sample = (1.0f - frac) * buffer[i1] + frac * buffer[i2];
+            sample_t sample = FractionalInterpolation::linear(buffer[i1], buffer[i2], frac);
     
             // Random for blend (between string and drum)
-            sample_t sign = (fastRand() > 0.0f) ? 1.0f : -1.0f;
+            sample_t sign = (noise.nextUint() & 0x80000000u) ? -1.0f : 1.0f;
             sample_t blended = (1.0f - blend) * sample + blend * sign * sample;
     
             // Apply lowpass 
@@ -91,15 +184,19 @@ namespace AudioUtils
     
             //Write new sample into delay line buffer
             buffer[writeIndex] = y;
-            writeIndex = (writeIndex + 1) % BUFFER_SIZE;
+            if (++writeIndex >= bufferSize) writeIndex = 0;
     
             return auClamp(y, -1.0f, 1.0f);
         }
-    
-    private:
-        sample_t buffer[BUFFER_SIZE];
+
+        int sampleRate;
+        sample_t lowestFundamental;
+        int bufferSize;
+        std::vector<sample_t> buffer;
         sample_t lowpassState;
         int writeIndex;
+        int flushIndex; //Where flushDenormals() got up to in the delay line
+        size_t unflushedSamples; //Samples written since the last flushDenormals()
         sample_t delayLength;
         sample_t targetDelay;
     
@@ -108,12 +205,7 @@ namespace AudioUtils
         sample_t lowpassCoeff;
         sample_t pluckPos;
     
-        uint32_t seed = 123456;
-        sample_t fastRand() // PRNG with range from -1.0 to +0.9999389648
-        {
-            seed = seed * 1664525 + 1013904223;
-            return ((seed >> 16) & 0x7FFF) / 16384.0f - 1.0f;
-        }
+        NoiseGenerator noise{123456};
     };
 
 } //Namespace AudioUtils
@@ -0,0 +1,356 @@
+/*
+
+au_KarplusStrongPool.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Polyphonic Karplus-Strong string/drum voices (same algorithm as KarplusStrong), rendered together.
+
+- Voice state is stored as one array per parameter. For each sample the read positions, then the interpolation, blend and
+  filtering are calculated for all voices in branch free loops, so voices run side by side in SIMD lanes. Only the buffer
+  reads and writes are done per voice.
+- Delay buffers are slots in one pool allocated at construction. Slot lengths are a power of two, so wrapping is a mask.
+- pluck() schedules a note at a sample offset within the next processBlock() call (or a later one). Free voices are used
+  first, otherwise the quietest voice is stolen. A voice is freed when its level has decayed below -90dB.
+- Damping, blend, low-pass and pluck position apply to the whole pool (new values affect all sounding voices).
+
+*/
+
+#pragma once
+
+#include "stdint.h"
+#include "au_config.h"
+#include "au_Noise.h"
+#include "au_FractionalDelayLine.h"
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+namespace AudioUtils
+{
+
+    template<unsigned int max_voices>
+    class KarplusStrongPool
+    {
+    public:
+
+        static constexpr unsigned int MAX_PENDING_PLUCKS = 64;
+        static constexpr unsigned int VOICE_LANES = 8;
+
+        /*
+        Allocates the buffer pool, so should be called outside of the audio thread.
+
+        Parameters:
+        sample_rate - sample rate in Hz
+        lowest_fundamental_hz - lowest frequency that can be played, sets the delay buffer length
+        */
+        KarplusStrongPool(int sample_rate = 48000, sample_t lowest_fundamental_hz = 20.0f)
+        {
+            m_sample_rate = sample_rate;
+            m_lowest_fundamental_hz = lowest_fundamental_hz;
+
+            unsigned long max_delay = static_cast<unsigned long>(sample_rate / lowest_fundamental_hz) + 2;
+            m_voice_buffer_length = 1;
+            while (m_voice_buffer_length < max_delay)
+            {
+                m_voice_buffer_length *= 2;
+            }
+            m_voice_buffer_mask = m_voice_buffer_length - 1;
+            m_buffer_pool.assign(m_voice_buffer_length * max_voices, 0.0f);
+
+            for (unsigned int voice = 0 ; voice < max_voices ; voice++)
+            {
+                m_buffers[voice] = &m_buffer_pool[voice * m_voice_buffer_length];
+                m_seeds[voice] = 123456 + (voice * 7919);
+            }
+        }
+
+        void setDamping(sample_t d) { m_damping = auClamp(d, 0.0f, 1.0f); }
+        void setBlend(sample_t b) { m_blend = auClamp(b, 0.0f, 1.0f); }
+        void setLowpass(sample_t a) { m_lowpass_coeff = auClamp(a, 0.0f, 1.0f); }
+        void setPluckPosition(sample_t pos) { m_pluck_position = auClamp(pos, 0.01f, 0.99f); }
+
+        /*
+        Schedule a pluck.
+
+        Parameters:
+        frequency_hz - fundamental, clamped between the lowest fundamental and Nyquist
+        amplitude - level of the excitation noise
+        sample_offset - sample within the next processBlock() call to start on. Offsets past the end of the block carry over.
+
+        Return: false if too many plucks are already pending
+        */
+        bool pluck(sample_t frequency_hz, sample_t amplitude = 1.0f, size_t sample_offset = 0)
+        {
+            if (m_num_pending == MAX_PENDING_PLUCKS)
+            {
+                return false;
+            }
+
+            //Keep pending plucks sorted by offset
+            unsigned int position = m_num_pending;
+            while (position > 0 && m_pending[position - 1].sample_offset > sample_offset)
+            {
+                m_pending[position] = m_pending[position - 1];
+                position--;
+            }
+            m_pending[position].sample_offset = sample_offset;
+            m_pending[position].frequency_hz = frequency_hz;
+            m_pending[position].amplitude = amplitude;
+            m_num_pending++;
+            return true;
+        }
+
+        /*
+        Render all voices, summed, into output_buffer (overwritten).
+        */
+        void processBlock(sample_t* output_buffer, size_t num_samples)
+        {
+            size_t i = 0;
+            unsigned int next_pluck = 0;
+            while (i < num_samples)
+            {
+                while (next_pluck < m_num_pending && m_pending[next_pluck].sample_offset <= i)
+                {
+                    startVoice(m_pending[next_pluck].frequency_hz, m_pending[next_pluck].amplitude);
+                    next_pluck++;
+                }
+                size_t end = num_samples;
+                if (next_pluck < m_num_pending && m_pending[next_pluck].sample_offset < end)
+                {
+                    end = m_pending[next_pluck].sample_offset;
+                }
+                renderVoices(&output_buffer[i], end - i);
+                i = end;
+            }
+
+            //Carry over plucks scheduled past the end of this block
+            unsigned int remaining = 0;
+            for (unsigned int p = next_pluck ; p < m_num_pending ; p++)
+            {
+                m_pending[remaining] = m_pending[p];
+                m_pending[remaining].sample_offset -= num_samples;
+                remaining++;
+            }
+            m_num_pending = remaining;
+
+            freeSilentVoices();
+        }
+
+        unsigned int getNumActiveVoices()
+        {
+            unsigned int count = 0;
+            for (unsigned int voice = 0 ; voice < max_voices ; voice++)
+            {
+                count += m_active[voice] ? 1 : 0;
+            }
+            return count;
+        }
+
+        /*
+        Silence all voices and cancel pending plucks.
+        */
+        void reset()
+        {
+            for (unsigned int voice = 0 ; voice < max_voices ; voice++)
+            {
+                m_active[voice] = false;
+                m_levels[voice] = 0;
+                m_lowpass_states[voice] = 0;
+            }
+            for (size_t i = 0 ; i < m_buffer_pool.size() ; i++)
+            {
+                m_buffer_pool[i] = 0;
+            }
+            m_num_pending = 0;
+            m_num_lanes_used = 0;
+        }
+
+    private:
+
+        struct PendingPluck
+        {
+            size_t sample_offset;
+            sample_t frequency_hz;
+            sample_t amplitude;
+        };
+
+        static constexpr sample_t SILENCE_LEVEL = 3.16e-5f; //-90dB
+        static constexpr sample_t LEVEL_DECAY = 0.999f;
+
+        void startVoice(sample_t frequency_hz, sample_t amplitude)
+        {
+            //Free voice, otherwise steal the quietest
+            unsigned int voice = 0;
+            for (unsigned int v = 0 ; v < max_voices ; v++)
+            {
+                if (!m_active[v])
+                {
+                    voice = v;
+                    break;
+                }
+                if (m_levels[v] < m_levels[voice])
+                {
+                    voice = v;
+                }
+            }
+
+            frequency_hz = auClamp(frequency_hz, m_lowest_fundamental_hz, m_sample_rate / 2);
+            sample_t delay = m_sample_rate / frequency_hz;
+            int len = static_cast<int>(delay);
+            sample_t* buffer = m_buffers[voice];
+            for (unsigned long i = 0 ; i < m_voice_buffer_length ; i++)
+            {
+                buffer[i] = 0;
+            }
+            m_noise.white(buffer, len);
+            for (int i = 0 ; i < len ; i++)
+            {
+                buffer[i] *= amplitude;
+            }
+            int M = static_cast<int>(m_pluck_position * len);
+            for (int i = M ; i < len ; i++)
+            {
+                buffer[i] -= buffer[i - M];
+            }
+
+            m_delay_lengths[voice] = static_cast<sample_t>(len);
+            m_target_delays[voice] = delay;
+            m_write_indexes[voice] = static_cast<uint32_t>(len) & m_voice_buffer_mask;
+            m_lowpass_states[voice] = 0;
+            m_levels[voice] = amplitude;
+            m_active[voice] = true;
+            updateLanesUsed();
+        }
+
+        void renderVoices(sample_t* output_buffer, size_t num_samples)
+        {
+            const unsigned int num_voices = m_num_lanes_used;
+            const sample_t damping = m_damping;
+            const sample_t lowpass_coeff = m_lowpass_coeff;
+            const sample_t lowpass_input_gain = 1.0f - lowpass_coeff;
+            const sample_t blend = m_blend;
+            const sample_t buffer_length = static_cast<sample_t>(m_voice_buffer_length);
+            const uint32_t mask = m_voice_buffer_mask;
+
+            alignas(64) uint32_t read_indexes[max_voices];
+            alignas(64) sample_t fractions[max_voices];
+            alignas(64) sample_t samples_1[max_voices];
+            alignas(64) sample_t samples_2[max_voices];
+            alignas(64) sample_t outputs[max_voices];
+
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                //Read positions, vectorised across voices
+                for (unsigned int v = 0 ; v < num_voices ; v++)
+                {
+                    //Change delay length gradually to avoid artefacts during plucks
+                    m_delay_lengths[v] += 0.01f * (m_target_delays[v] - m_delay_lengths[v]);
+
+                    sample_t read_position = static_cast<sample_t>(m_write_indexes[v]) - m_delay_lengths[v];
+                    read_position += read_position < 0 ? buffer_length : 0.0f;
+                    read_indexes[v] = static_cast<uint32_t>(read_position);
+                    fractions[v] = read_position - static_cast<sample_t>(read_indexes[v]);
+                }
+
+                //Gather from each voice's buffer
+                for (unsigned int v = 0 ; v < num_voices ; v++)
+                {
+                    samples_1[v] = m_buffers[v][read_indexes[v] & mask];
+                    samples_2[v] = m_buffers[v][(read_indexes[v] + 1) & mask];
+                }
+
+                //Interpolation, blend and filtering, vectorised across voices
+                sample_t sum = 0;
+                for (unsigned int v = 0 ; v < num_voices ; v++)
+                {
+                    sample_t sample = FractionalInterpolation::linear(samples_1[v], samples_2[v], fractions[v]);
+
+                    //Random sign for blend (between string and drum), from the top bit of each voice's generator
+                    m_seeds[v] = (m_seeds[v] * 1664525u) + 1013904223u;
+                    sample_t sign = 1.0f - static_cast<sample_t>(m_seeds[v] >> 31) * 2.0f;
+                    sample_t blended = sample * ((1.0f - blend) + (blend * sign));
+
+                    m_lowpass_states[v] = (lowpass_input_gain * blended) + (lowpass_coeff * m_lowpass_states[v]);
+                    sample_t y = damping * m_lowpass_states[v];
+                    outputs[v] = y;
+
+                    sample_t level = fabsf(y);
+                    sample_t decayed_level = m_levels[v] * LEVEL_DECAY;
+                    m_levels[v] = level > decayed_level ? level : decayed_level;
+
+                    sum += y > 1.0f ? 1.0f : (y < -1.0f ? -1.0f : y);
+                }
+                output_buffer[n] = sum;
+
+                //Scatter back into each voice's buffer
+                for (unsigned int v = 0 ; v < num_voices ; v++)
+                {
+                    m_buffers[v][m_write_indexes[v]] = outputs[v];
+                    m_write_indexes[v] = (m_write_indexes[v] + 1) & mask;
+                }
+            }
+        }
+
+        void freeSilentVoices()
+        {
+            for (unsigned int voice = 0 ; voice < m_num_lanes_used ; voice++)
+            {
+                if (m_active[voice] && m_levels[voice] < SILENCE_LEVEL)
+                {
+                    //Voice may still be rendered as part of a lane group, so make sure it renders silence
+                    m_active[voice] = false;
+                    m_levels[voice] = 0;
+                    m_lowpass_states[voice] = 0;
+                    for (unsigned long i = 0 ; i < m_voice_buffer_length ; i++)
+                    {
+                        m_buffers[voice][i] = 0;
+                    }
+                }
+            }
+            updateLanesUsed();
+        }
+
+        //Only voices up to the last active one are rendered, rounded up to a whole number of SIMD lanes
+        void updateLanesUsed()
+        {
+            unsigned int last_active = 0;
+            for (unsigned int voice = 0 ; voice < max_voices ; voice++)
+            {
+                if (m_active[voice])
+                {
+                    last_active = voice + 1;
+                }
+            }
+            unsigned int lanes = ((last_active + VOICE_LANES - 1) / VOICE_LANES) * VOICE_LANES;
+            m_num_lanes_used = lanes < max_voices ? lanes : max_voices;
+        }
+
+        int m_sample_rate;
+        sample_t m_lowest_fundamental_hz;
+        unsigned long m_voice_buffer_length;
+        uint32_t m_voice_buffer_mask;
+        std::vector<sample_t> m_buffer_pool;
+
+        alignas(64) sample_t* m_buffers[max_voices];
+        alignas(64) sample_t m_delay_lengths[max_voices] = {};
+        alignas(64) sample_t m_target_delays[max_voices] = {};
+        alignas(64) sample_t m_lowpass_states[max_voices] = {};
+        alignas(64) sample_t m_levels[max_voices] = {};
+        alignas(64) uint32_t m_write_indexes[max_voices] = {};
+        alignas(64) uint32_t m_seeds[max_voices];
+        NoiseGenerator m_noise{123456};
+        bool m_active[max_voices] = {};
+        unsigned int m_num_lanes_used = 0;
+
+        sample_t m_damping = 0.98f;
+        sample_t m_blend = 0.9f;
+        sample_t m_lowpass_coeff = 0.5f;
+        sample_t m_pluck_position = 0.2f;
+
+        PendingPluck m_pending[MAX_PENDING_PLUCKS];
+        unsigned int m_num_pending = 0;
+    };
+
+} //Namespace AudioUtils
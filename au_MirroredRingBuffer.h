@@ -0,0 +1,255 @@
+/*
+
+au_MirroredRingBuffer.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+History ring buffer for long lookback recording and analysis windows, sized at runtime (Linux only).
+
+The same memory (a memfd) is mapped twice, back to back, so the item after the last one in the buffer is the first one again.
+Any window of up to getLength() items is therefore one contiguous pointer, even when it straddles the wrap point, and can be
+passed straight to e.g. WholeWindowGoertzel or FFT code without being copied out first. Writes are contiguous for the same
+reason, so a block is written with a single copy (or directly via getWritePointer()/commitWrite()).
+
+Writes always succeed, overwriting the oldest items (it keeps the most recent getLength() items).
+
+The length is rounded up to a whole number of pages (2MB pages when huge pages are used). Huge pages need to be reserved
+by the system (e.g. /proc/sys/vm/nr_hugepages), setup() falls back to normal pages if they are not available.
+setup() allocates and maps memory, so should be called outside of the audio thread.
+
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+template<typename T>
+class MirroredRingBuffer
+{
+public:
+
+    MirroredRingBuffer() {}
+
+    MirroredRingBuffer(size_t min_length, bool use_huge_pages = false)
+    {
+        setup(min_length, use_huge_pages);
+    }
+
+    ~MirroredRingBuffer()
+    {
+        release();
+    }
+
+    MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+    MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+
+    /*
+    Allocate the buffer. Any previous contents are released.
+
+    Parameters:
+    min_length - minimum number of items to hold, rounded up to a whole number of pages
+    use_huge_pages - try to back the buffer with 2MB huge pages, falls back to normal pages if they aren't available
+
+    Return: false if the buffer couldn't be mapped (or not on Linux)
+    */
+    bool setup(size_t min_length, bool use_huge_pages = false)
+    {
+        release();
+        if (min_length == 0)
+        {
+            return false;
+        }
+        if (use_huge_pages && map(min_length, true))
+        {
+            return true;
+        }
+        return map(min_length, false);
+    }
+
+    /*
+    Number of items the buffer holds (0 if not set up).
+    */
+    size_t getLength()
+    {
+        return m_length;
+    }
+
+    /*
+    Number of valid items in the buffer, i.e. items written so far up to getLength().
+    */
+    size_t getNumItems()
+    {
+        return m_num_items;
+    }
+
+    bool isUsingHugePages()
+    {
+        return m_using_huge_pages;
+    }
+
+    void write(T new_item)
+    {
+        m_data[m_write_index] = new_item;
+        commitWrite(1);
+    }
+
+    /*
+    Write a block of items. If more than getLength() items are written only the last getLength() are kept.
+    */
+    void write(const T* items, size_t num_items)
+    {
+        if (num_items > m_length)
+        {
+            items += num_items - m_length;
+            num_items = m_length;
+        }
+        memcpy(getWritePointer(), items, num_items * sizeof(T));
+        commitWrite(num_items);
+    }
+
+    /*
+    Contiguous space for up to getLength() items, to write new items into directly. Call commitWrite() afterwards.
+    */
+    T* getWritePointer()
+    {
+        return &m_data[m_write_index];
+    }
+
+    /*
+    Add num_items items written via getWritePointer() to the buffer. Must not be more than getLength().
+    */
+    void commitWrite(size_t num_items)
+    {
+        m_write_index += num_items;
+        if (m_write_index >= m_length)
+        {
+            m_write_index -= m_length;
+        }
+        m_num_items = (m_num_items + num_items) < m_length ? (m_num_items + num_items) : m_length;
+    }
+
+    /*
+    Get a contiguous window of past items, oldest first.
+
+    Parameters:
+    window_length - number of items in the window, up to getLength()
+    delay - number of items between the newest item of the window and the most recently written item (0 gives the latest window).
+            window_length + delay must not be more than getLength().
+    */
+    const T* getWindow(size_t window_length, size_t delay = 0)
+    {
+        return &m_data[m_write_index + m_length - window_length - delay];
+    }
+
+    /*
+    Zero the contents.
+    */
+    void clear()
+    {
+        if (m_data != nullptr)
+        {
+            memset(m_data, 0, m_length * sizeof(T));
+        }
+        m_write_index = 0;
+        m_num_items = 0;
+    }
+
+    /*
+    Unmap the buffer.
+    */
+    void release()
+    {
+#ifdef __linux__
+        if (m_reservation != nullptr)
+        {
+            munmap(m_reservation, m_reservation_bytes);
+        }
+#endif
+        m_reservation = nullptr;
+        m_reservation_bytes = 0;
+        m_data = nullptr;
+        m_length = 0;
+        m_write_index = 0;
+        m_num_items = 0;
+        m_using_huge_pages = false;
+    }
+
+private:
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    bool map(size_t min_length, bool use_huge_pages)
+    {
+#ifdef __linux__
+        size_t page_size = use_huge_pages ? HUGE_PAGE_SIZE : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        if (page_size % sizeof(T) != 0)
+        {
+            return false;
+        }
+        size_t num_bytes = ((min_length * sizeof(T) + page_size - 1) / page_size) * page_size;
+
+        int fd = memfd_create("au_MirroredRingBuffer", use_huge_pages ? MFD_HUGETLB : 0);
+        if (fd < 0)
+        {
+            return false;
+        }
+        if (ftruncate(fd, num_bytes) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        //Reserve address space for both copies (plus alignment for huge pages), then map the memfd over it twice
+        size_t reservation_bytes = (2 * num_bytes) + (use_huge_pages ? page_size : 0);
+        void* reservation = mmap(nullptr, reservation_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reservation == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+        char* base = static_cast<char*>(reservation);
+        size_t misalignment = reinterpret_cast<size_t>(base) % page_size;
+        if (misalignment != 0)
+        {
+            base += page_size - misalignment;
+        }
+
+        void* first = mmap(base, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        void* second = mmap(base + num_bytes, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        //Mappings keep the memory alive, the fd isn't needed any more
+        close(fd);
+        if (first == MAP_FAILED || second == MAP_FAILED)
+        {
+            munmap(reservation, reservation_bytes);
+            return false;
+        }
+
+        m_reservation = reservation;
+        m_reservation_bytes = reservation_bytes;
+        m_data = reinterpret_cast<T*>(base);
+        m_length = num_bytes / sizeof(T);
+        m_using_huge_pages = use_huge_pages;
+        clear();
+        return true;
+#else
+        (void)min_length;
+        (void)use_huge_pages;
+        return false;
+#endif
+    }
+
+    void* m_reservation = nullptr;
+    size_t m_reservation_bytes = 0;
+    T* m_data = nullptr;
+    size_t m_length = 0;
+    size_t m_write_index = 0;
+    size_t m_num_items = 0;
+    bool m_using_huge_pages = false;
+};
@@ -0,0 +1,148 @@
+/*
+
+au_MultiTapDelay.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Multi-tap delay. All taps read from one shared buffer, and the output is the sum of the taps, each with its own delay and gain.
+
+Taps can have fractional delays (linearly interpolated). The buffer is stored mirrored (each sample written twice, buffer length
+apart) so every tap's reads for a block are contiguous. processBlock() writes a chunk of input then adds each tap's whole chunk
+to the output in one loop, so each tap costs a couple of vectorised multiply-adds per sample.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_FractionalDelayLine.h"
+#include <stddef.h>
+
+template<unsigned long max_delay_samples, unsigned int max_taps>
+class MultiTapDelay
+{
+public:
+
+    static constexpr unsigned int BLOCK_CHUNK = 64;
+
+    MultiTapDelay()
+    {
+        clear();
+    }
+
+    /*
+    Set the number of active taps (up to max_taps). Taps are numbered from 0.
+    */
+    void setNumTaps(unsigned int num_taps)
+    {
+        m_num_taps = num_taps < max_taps ? num_taps : max_taps;
+    }
+
+    unsigned int getNumTaps()
+    {
+        return m_num_taps;
+    }
+
+    /*
+    Set the delay and gain of a tap.
+
+    Parameters:
+    tap - tap number, less than max_taps
+    delay_samples - delay in samples, clamped to 0 - max_delay_samples
+    gain - linear gain of the tap
+
+    Return: false if the tap number is out of range
+    */
+    bool setTap(unsigned int tap, sample_t delay_samples, sample_t gain)
+    {
+        if (tap >= max_taps)
+        {
+            return false;
+        }
+        delay_samples = auClamp(delay_samples, 0.0f, static_cast<sample_t>(max_delay_samples));
+        unsigned long whole = static_cast<unsigned long>(delay_samples);
+        sample_t fraction = delay_samples - whole;
+        m_tap_delays[tap] = whole;
+        //Linear interpolation weights folded into the tap gain, so the block loop is just multiply-adds
+        sample_t newer_weight, older_weight;
+        FractionalInterpolation::linearWeights(fraction, newer_weight, older_weight);
+        m_tap_gains_newer[tap] = gain * newer_weight;
+        m_tap_gains_older[tap] = gain * older_weight;
+        return true;
+    }
+
+    sample_t process(sample_t input_sample)
+    {
+        sample_t output_sample;
+        processBlock(&input_sample, &output_sample, 1);
+        return output_sample;
+    }
+
+    /*
+    Process a block. Input and output can be the same buffer.
+    */
+    void processBlock(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t chunk = (num_samples - i) < BLOCK_CHUNK ? (num_samples - i) : BLOCK_CHUNK;
+            processChunk(&input_buffer[i], &output_buffer[i], chunk);
+            i += chunk;
+        }
+    }
+
+    void clear()
+    {
+        for (unsigned long i = 0 ; i < 2 * Buffer::LENGTH ; i++)
+        {
+            m_buffer[i] = 0;
+        }
+        m_write_index = 0;
+    }
+
+private:
+
+    //Room for the longest delay plus a whole chunk written ahead of the reads
+    typedef PowerOfTwoBuffer<max_delay_samples + BLOCK_CHUNK + 2> Buffer;
+
+    void processChunk(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        //Whole chunk is written first (to both halves), so a tap with a delay of 0 reads the current input
+        const unsigned long first_index = m_write_index;
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            unsigned long index = (first_index + n) & Buffer::MASK;
+            m_buffer[index] = input_buffer[n];
+            m_buffer[index + Buffer::LENGTH] = input_buffer[n];
+        }
+        m_write_index = (first_index + num_samples) & Buffer::MASK;
+
+        sample_t sum[BLOCK_CHUNK] = {};
+        for (unsigned int tap = 0 ; tap < m_num_taps ; tap++)
+        {
+            //Sample before the tap's first read, so both reads of the chunk are contiguous runs from here
+            const sample_t* older = &m_buffer[(first_index - m_tap_delays[tap] - 1) & Buffer::MASK];
+            const sample_t* newer = older + 1;
+            const sample_t gain_newer = m_tap_gains_newer[tap];
+            const sample_t gain_older = m_tap_gains_older[tap];
+            for (size_t n = 0 ; n < num_samples ; n++)
+            {
+                sum[n] += (gain_newer * newer[n]) + (gain_older * older[n]);
+            }
+        }
+        for (size_t n = 0 ; n < num_samples ; n++)
+        {
+            output_buffer[n] = sum[n];
+        }
+    }
+
+    sample_t m_buffer[2 * Buffer::LENGTH];
+    unsigned long m_write_index = 0;
+
+    unsigned int m_num_taps = 0;
+    unsigned long m_tap_delays[max_taps] = {};
+    sample_t m_tap_gains_newer[max_taps] = {};
+    sample_t m_tap_gains_older[max_taps] = {};
+};
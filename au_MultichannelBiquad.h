@@ -0,0 +1,146 @@
+/*
+
+au_MultichannelBiquad.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Runs one biquad per channel for a fixed number of channels (typically 4, 8 or 16).
+Coefficients and state are stored in structure-of-arrays layout, so the per-channel update in processFrame()
+is a straight loop over contiguous arrays that the compiler turns into one SSE/AVX/NEON lane per channel.
+Larger channel counts can be handled with several instances (e.g. 4 x MultichannelBiquad<16> for 64 channels).
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_Biquad.h"
+#include <stddef.h>
+
+template<unsigned int num_channels>
+class MultichannelBiquad
+{
+public:
+
+    MultichannelBiquad()
+    {
+        Biquad::Coefficients passthrough = {1.0, 0.0, 0.0, 0.0, 0.0};
+        for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+        {
+            setCoefficients(channel, passthrough);
+        }
+        clean();
+    }
+
+    /*
+    Design and apply a filter to a single channel. The state of that channel is cleared.
+    */
+    void setup(unsigned int channel, Biquad::FilterSetup filter_setup)
+    {
+        setCoefficients(channel, Biquad::designCoefficients(filter_setup));
+        m_z1[channel] = 0;
+        m_z2[channel] = 0;
+    }
+
+    /*
+    Design and apply the same filter to every channel.
+    */
+    void setupAllChannels(Biquad::FilterSetup filter_setup)
+    {
+        Biquad::Coefficients coefficients = Biquad::designCoefficients(filter_setup);
+        for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+        {
+            setCoefficients(channel, coefficients);
+        }
+        clean();
+    }
+
+    void setCoefficients(unsigned int channel, Biquad::Coefficients biquad_coefficients)
+    {
+        m_a0[channel] = biquad_coefficients.a0;
+        m_a1[channel] = biquad_coefficients.a1;
+        m_a2[channel] = biquad_coefficients.a2;
+        m_b1[channel] = biquad_coefficients.b1;
+        m_b2[channel] = biquad_coefficients.b2;
+    }
+
+    Biquad::Coefficients getCoefficients(unsigned int channel)
+    {
+        return {m_a0[channel], m_a1[channel], m_a2[channel], m_b1[channel], m_b2[channel]};
+    }
+
+    /*
+    Process one frame (one sample for every channel).
+
+    Parameters:
+    input_frame - num_channels input samples
+    output_frame - num_channels output samples. Can be the same as input_frame.
+    */
+    void processFrame(const sample_t* input_frame, sample_t* output_frame)
+    {
+        for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+        {
+            sample_t input_sample = input_frame[channel];
+            sample_t output_sample = (input_sample * m_a0[channel]) + m_z1[channel];
+            m_z1[channel] = (input_sample * m_a1[channel]) + m_z2[channel] - (output_sample * m_b1[channel]);
+            m_z2[channel] = (input_sample * m_a2[channel]) - (output_sample * m_b2[channel]);
+            output_frame[channel] = output_sample;
+        }
+    }
+
+    /*
+    Process a block of interleaved frames. Input and output can be the same buffer.
+    */
+    void processInterleaved(const sample_t* input_buffer, sample_t* output_buffer, size_t num_frames)
+    {
+        for (size_t frame = 0 ; frame < num_frames ; frame++)
+        {
+            processFrame(&input_buffer[frame * num_channels], &output_buffer[frame * num_channels]);
+        }
+    }
+
+    /*
+    Process a block of non-interleaved audio, with one buffer per channel. Input and output buffers can be the same.
+    */
+    void processPlanar(const sample_t* const* input_buffers, sample_t* const* output_buffers, size_t num_samples)
+    {
+        alignas(64) sample_t frame[num_channels];
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+            {
+                frame[channel] = input_buffers[channel][i];
+            }
+            processFrame(frame, frame);
+            for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+            {
+                output_buffers[channel][i] = frame[channel];
+            }
+        }
+    }
+
+    void clean()
+    {
+        for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+        {
+            m_z1[channel] = 0;
+            m_z2[channel] = 0;
+        }
+    }
+
+    static constexpr unsigned int getNumChannels()
+    {
+        return num_channels;
+    }
+
+private:
+    alignas(64) sample_t m_a0[num_channels];
+    alignas(64) sample_t m_a1[num_channels];
+    alignas(64) sample_t m_a2[num_channels];
+    alignas(64) sample_t m_b1[num_channels];
+    alignas(64) sample_t m_b2[num_channels];
+
+    alignas(64) sample_t m_z1[num_channels];
+    alignas(64) sample_t m_z2[num_channels];
+};
@@ -5,36 +5,71 @@ au_Onepole.h
 Author: Matt Davison
 Date: 04/03/2024
 
+Templated on sample type: Onepole (float), BasicOnepole<double>, or BasicOnepole<Q15>/BasicOnepole<Q31> (see au_FixedPoint.h)
+for fixed point. All coefficients are within -1 to 1, so the fixed point versions need no extra scaling.
+
 */
 
 #pragma once
 
 #include "au_config.h"
+#include "au_Denormals.h"
 
-class Onepole
+template<typename sample_type>
+class BasicOnepole
 {
 
 public:
 
-    Onepole(sample_t b1_value = 0.0, bool normalise_gain = true)
+    BasicOnepole(sample_type b1_value = sample_type(0), bool normalise_gain = true)
     {
         setB1(b1_value, normalise_gain);
     }
 
-    void setB1(sample_t b1_value, bool normalise_gain = true)
+    void setB1(sample_type b1_value, bool normalise_gain = true)
     {
         m_b1 = b1_value;
         if (normalise_gain)
         {
-            m_a0 = 1 - abs(m_b1);
+            m_a0 = sample_type(1) - (m_b1 < sample_type(0) ? -m_b1 : m_b1);
         }
     }
-    sample_t process(sample_t input_sample)
+
+    /*
+    Set a normalised lowpass (smoother) by its time constant, the time taken to cover 63% of a step.
+    */
+    void setTimeConstant(double time_constant_s, double sample_rate_hz)
+    {
+        setB1(timeConstantToB1(time_constant_s, sample_rate_hz));
+    }
+
+    /*
+    Return: lowpass b1 coefficient (-e^(-1 / time constant in samples)) for a time constant. 0 (no smoothing) for time
+    constants of 0 or less.
+    */
+    static sample_type timeConstantToB1(double time_constant_s, double sample_rate_hz)
+    {
+        double time_constant_samples = time_constant_s * sample_rate_hz;
+        return time_constant_samples > 0 ? sample_type(-exp(-1.0 / time_constant_samples)) : sample_type(0);
+    }
+
+    sample_type process(sample_type input_sample)
     {
-        m_z1 = (input_sample * m_a0) + (m_z1 * m_b1 * -1.0);
+        m_z1 = (input_sample * m_a0) - (m_z1 * m_b1);
         return m_z1;
     }
 
+    /*
+    Zero state that has decayed below DENORMAL_FLUSH_THRESHOLD. Call once per block to keep silent tails out of the denormal
+    range (see au_Denormals.h). Does nothing for fixed point sample types, which have no denormals.
+    */
+    void flushDenormals()
+    {
+        m_z1 = flushDenormal(m_z1);
+    }
+
 private:
-    sample_t m_a0, m_b1, m_z1 = 0.0;
-};
\ No newline at end of file
+    sample_type m_a0, m_b1, m_z1 = sample_type(0);
+};
+
+typedef BasicOnepole<sample_t> Onepole;
@@ -0,0 +1,319 @@
+/*
+
+au_PcmConverter.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Block conversion between sample_t and PCM formats (int16, packed 24 bit, int32, float32), with optional interleaving.
+
+Integer scaling matches intToNormalised()/normalisedToInt() in au_config.h exactly: negative values are scaled by the
+magnitude of the minimum integer and positive values by the maximum (e.g. -32768 -> -1.0, 32767 -> 1.0). Conversion to integer
+truncates towards zero like normalisedToInt(). Unlike normalisedToInt(), it also saturates, so input outside -1.0 to 1.0 clips
+instead of overflowing. With dither it rounds to nearest instead, as dither needs evenly spaced quantisation steps.
+INT24 is packed little endian, 3 bytes per sample, with the same scaling for 24 bit limits.
+
+The conversion loops are branch free (selects rather than branches on sign and range), so they vectorise. Interleaving works in
+chunks of CHUNK_SAMPLES: a contiguous chunk of the interleaved buffer is converted in one vectorised pass, then shuffled to or
+from the channel buffers while it is still in cache.
+
+Optional TPDF dither (+/-1 LSB, see NoiseGenerator::tpdf()) can be added before conversion to integer.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_Noise.h"
+#include "stdint.h"
+#include <limits>
+#include <math.h>
+#include <stddef.h>
+
+class PcmConverter
+{
+public:
+
+    enum class PcmFormat
+    {
+        INT16,
+        INT24,      //Packed, 3 bytes per sample, little endian
+        INT32,
+        FLOAT32
+    };
+
+    static constexpr unsigned int CHUNK_SAMPLES = 1024;
+    static constexpr unsigned int MAX_CHANNELS = CHUNK_SAMPLES;
+
+    static size_t getBytesPerSample(PcmFormat format)
+    {
+        switch (format)
+        {
+        case PcmFormat::INT16:
+            return 2;
+        case PcmFormat::INT24:
+            return 3;
+        default:
+            return 4;
+        }
+    }
+
+    /*
+    Convert a contiguous buffer of PCM samples to sample_t.
+    */
+    static void toFloat(const void* input_buffer, PcmFormat format, sample_t* output_buffer, size_t num_samples)
+    {
+        switch (format)
+        {
+        case PcmFormat::INT16:
+            intToFloat(static_cast<const int16_t*>(input_buffer), output_buffer, num_samples,
+                       std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::min());
+            break;
+        case PcmFormat::INT24:
+            int24ToFloat(static_cast<const uint8_t*>(input_buffer), output_buffer, num_samples);
+            break;
+        case PcmFormat::INT32:
+            intToFloat(static_cast<const int32_t*>(input_buffer), output_buffer, num_samples,
+                       std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min());
+            break;
+        case PcmFormat::FLOAT32:
+            copyFloat(static_cast<const float*>(input_buffer), output_buffer, num_samples);
+            break;
+        }
+    }
+
+    /*
+    Convert a contiguous buffer of sample_t to PCM samples.
+
+    Parameters:
+    dither - generator for TPDF dither, or nullptr for none (truncate). Not used for FLOAT32.
+    */
+    static void fromFloat(const sample_t* input_buffer, void* output_buffer, PcmFormat format, size_t num_samples,
+                          NoiseGenerator* dither = nullptr)
+    {
+        if (dither == nullptr || format == PcmFormat::FLOAT32)
+        {
+            quantise<false>(input_buffer, output_buffer, format, num_samples);
+            return;
+        }
+
+        uint8_t* output = static_cast<uint8_t*>(output_buffer);
+        const size_t bytes_per_sample = getBytesPerSample(format);
+        const sample_t lsb = 1.0f / static_cast<sample_t>(getMaxValue(format));
+        alignas(64) sample_t dithered[CHUNK_SAMPLES];
+        for (size_t i = 0 ; i < num_samples ; i += CHUNK_SAMPLES)
+        {
+            size_t chunk = (num_samples - i) < CHUNK_SAMPLES ? (num_samples - i) : CHUNK_SAMPLES;
+            dither->tpdf(dithered, chunk, lsb);
+            for (size_t n = 0 ; n < chunk ; n++)
+            {
+                dithered[n] += input_buffer[i + n];
+            }
+            quantise<true>(dithered, output + (i * bytes_per_sample), format, chunk);
+        }
+    }
+
+    /*
+    Convert an interleaved PCM buffer to separate sample_t channel buffers.
+
+    Parameters:
+    channel_buffers - one output buffer per channel, each num_frames long
+
+    Return: false if num_channels is 0 or more than MAX_CHANNELS
+    */
+    static bool deinterleave(const void* interleaved_buffer, PcmFormat format, sample_t* const* channel_buffers,
+                             unsigned int num_channels, size_t num_frames)
+    {
+        if (num_channels == 0 || num_channels > MAX_CHANNELS)
+        {
+            return false;
+        }
+
+        const uint8_t* input = static_cast<const uint8_t*>(interleaved_buffer);
+        const size_t bytes_per_frame = getBytesPerSample(format) * num_channels;
+        const size_t chunk_frames = CHUNK_SAMPLES / num_channels;
+        alignas(64) sample_t chunk[CHUNK_SAMPLES];
+        for (size_t frame = 0 ; frame < num_frames ; frame += chunk_frames)
+        {
+            size_t frames = (num_frames - frame) < chunk_frames ? (num_frames - frame) : chunk_frames;
+            toFloat(input + (frame * bytes_per_frame), format, chunk, frames * num_channels);
+            for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+            {
+                sample_t* output = channel_buffers[channel] + frame;
+                for (size_t n = 0 ; n < frames ; n++)
+                {
+                    output[n] = chunk[(n * num_channels) + channel];
+                }
+            }
+        }
+        return true;
+    }
+
+    /*
+    Convert separate sample_t channel buffers to an interleaved PCM buffer.
+
+    Parameters:
+    channel_buffers - one input buffer per channel, each num_frames long
+    dither - generator for TPDF dither, or nullptr for none. Not used for FLOAT32.
+
+    Return: false if num_channels is 0 or more than MAX_CHANNELS
+    */
+    static bool interleave(const sample_t* const* channel_buffers, void* interleaved_buffer, PcmFormat format,
+                           unsigned int num_channels, size_t num_frames, NoiseGenerator* dither = nullptr)
+    {
+        if (num_channels == 0 || num_channels > MAX_CHANNELS)
+        {
+            return false;
+        }
+
+        uint8_t* output = static_cast<uint8_t*>(interleaved_buffer);
+        const size_t bytes_per_frame = getBytesPerSample(format) * num_channels;
+        const size_t chunk_frames = CHUNK_SAMPLES / num_channels;
+        alignas(64) sample_t chunk[CHUNK_SAMPLES];
+        for (size_t frame = 0 ; frame < num_frames ; frame += chunk_frames)
+        {
+            size_t frames = (num_frames - frame) < chunk_frames ? (num_frames - frame) : chunk_frames;
+            for (unsigned int channel = 0 ; channel < num_channels ; channel++)
+            {
+                const sample_t* input = channel_buffers[channel] + frame;
+                for (size_t n = 0 ; n < frames ; n++)
+                {
+                    chunk[(n * num_channels) + channel] = input[n];
+                }
+            }
+            fromFloat(chunk, output + (frame * bytes_per_frame), format, frames * num_channels, dither);
+        }
+        return true;
+    }
+
+private:
+
+    static constexpr int32_t INT24_MAX = 8388607;
+    static constexpr int32_t INT24_MIN = -8388608;
+
+    static int32_t getMaxValue(PcmFormat format)
+    {
+        switch (format)
+        {
+        case PcmFormat::INT16:
+            return std::numeric_limits<int16_t>::max();
+        case PcmFormat::INT24:
+            return INT24_MAX;
+        default:
+            return std::numeric_limits<int32_t>::max();
+        }
+    }
+
+    template<bool round_to_nearest>
+    static void quantise(const sample_t* input_buffer, void* output_buffer, PcmFormat format, size_t num_samples)
+    {
+        switch (format)
+        {
+        case PcmFormat::INT16:
+            floatToInt<round_to_nearest>(input_buffer, static_cast<int16_t*>(output_buffer), num_samples,
+                       std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::min());
+            break;
+        case PcmFormat::INT24:
+            floatToInt24<round_to_nearest>(input_buffer, static_cast<uint8_t*>(output_buffer), num_samples);
+            break;
+        case PcmFormat::INT32:
+            floatToInt<round_to_nearest>(input_buffer, static_cast<int32_t*>(output_buffer), num_samples,
+                       std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min());
+            break;
+        case PcmFormat::FLOAT32:
+            copyFloat(input_buffer, static_cast<float*>(output_buffer), num_samples);
+            break;
+        }
+    }
+
+    //Same result as intToNormalised(): -value / min is the same as value / -min
+    template<typename int_type>
+    static void intToFloat(const int_type* input_buffer, sample_t* output_buffer, size_t num_samples, int_type max_value, int_type min_value)
+    {
+        const sample_t positive_scale = static_cast<sample_t>(max_value);
+        const sample_t negative_scale = -static_cast<sample_t>(min_value);
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            sample_t value = static_cast<sample_t>(input_buffer[i]);
+            output_buffer[i] = value / (input_buffer[i] < 0 ? negative_scale : positive_scale);
+        }
+    }
+
+    /*
+    Truncating: same result as normalisedToInt() for input within -1.0 to 1.0, saturating outside it.
+    Rounding to nearest: used with dither, which needs evenly spaced quantisation steps (truncation towards zero makes the step
+    around 0 twice as wide).
+    */
+    template<bool round_to_nearest, typename int_type>
+    static void floatToInt(const sample_t* input_buffer, int_type* output_buffer, size_t num_samples, int_type max_value, int_type min_value)
+    {
+        const sample_t positive_scale = static_cast<sample_t>(max_value);
+        const sample_t negative_scale = -static_cast<sample_t>(min_value);
+        //float(INT32_MAX) rounds up to 2^31, which doesn't fit, so saturated values are converted from a value that does and
+        //replaced afterwards. Converting unconditionally keeps the loop branch free.
+        const sample_t largest_convertible = nextafterf(positive_scale, 0.0f);
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            //-value * min is the same as value * -min, so in range values give exactly the normalisedToInt() result
+            sample_t value = input_buffer[i];
+            sample_t scaled = value * (value < 0 ? negative_scale : positive_scale);
+            if (round_to_nearest)
+            {
+                scaled += value < 0 ? -0.5f : 0.5f;
+            }
+            //Clamped after scaling rather than before, as GCC threads a clamp on value into branches around the multiply.
+            //Written so NaN fails both compares and ends up clipped rather than undefined.
+            scaled = scaled < positive_scale ? scaled : positive_scale;
+            scaled = scaled > -negative_scale ? scaled : -negative_scale;
+            bool saturated = scaled >= positive_scale;
+            int_type converted = static_cast<int_type>(saturated ? largest_convertible : scaled);
+            output_buffer[i] = saturated ? max_value : converted;
+        }
+    }
+
+    static void int24ToFloat(const uint8_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        alignas(64) int32_t unpacked[CHUNK_SAMPLES];
+        for (size_t i = 0 ; i < num_samples ; i += CHUNK_SAMPLES)
+        {
+            size_t chunk = (num_samples - i) < CHUNK_SAMPLES ? (num_samples - i) : CHUNK_SAMPLES;
+            const uint8_t* input = input_buffer + (3 * i);
+            for (size_t n = 0 ; n < chunk ; n++)
+            {
+                //Assemble in the top 24 bits, then arithmetic shift down to sign extend
+                uint32_t word = (static_cast<uint32_t>(input[3 * n]) << 8) | (static_cast<uint32_t>(input[(3 * n) + 1]) << 16)
+                              | (static_cast<uint32_t>(input[(3 * n) + 2]) << 24);
+                unpacked[n] = static_cast<int32_t>(word) >> 8;
+            }
+            intToFloat(unpacked, output_buffer + i, chunk, INT24_MAX, INT24_MIN);
+        }
+    }
+
+    template<bool round_to_nearest>
+    static void floatToInt24(const sample_t* input_buffer, uint8_t* output_buffer, size_t num_samples)
+    {
+        alignas(64) int32_t unpacked[CHUNK_SAMPLES];
+        for (size_t i = 0 ; i < num_samples ; i += CHUNK_SAMPLES)
+        {
+            size_t chunk = (num_samples - i) < CHUNK_SAMPLES ? (num_samples - i) : CHUNK_SAMPLES;
+            floatToInt<round_to_nearest>(input_buffer + i, unpacked, chunk, INT24_MAX, INT24_MIN);
+            uint8_t* output = output_buffer + (3 * i);
+            for (size_t n = 0 ; n < chunk ; n++)
+            {
+                uint32_t word = static_cast<uint32_t>(unpacked[n]);
+                output[3 * n] = static_cast<uint8_t>(word);
+                output[(3 * n) + 1] = static_cast<uint8_t>(word >> 8);
+                output[(3 * n) + 2] = static_cast<uint8_t>(word >> 16);
+            }
+        }
+    }
+
+    template<typename input_type, typename output_type>
+    static void copyFloat(const input_type* input_buffer, output_type* output_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            output_buffer[i] = static_cast<output_type>(input_buffer[i]);
+        }
+    }
+};
@@ -5,36 +5,116 @@ au_RectangularWave.h
 Author: Matt Davison
 Date: 30/12/2023
 
-Note that this is a very basic implementation of a rectangular wave generator, with no interpolation implemented.
+Band-limited rectangular (pulse), sawtooth and triangle wave generator for audio, plus a digital output for PWM.
+
+process()/processBlock() - audio output. The naive waveform's discontinuities alias heavily, so each one is smoothed with a
+    2 sample polynomial correction: PolyBLEP for steps (pulse, saw) and PolyBLAMP for changes of slope (triangle). This removes
+    most audible aliasing without oversampling. Frequency and duty cycle can be changed at any time, or modulated per sample
+    through processBlock(), and the phase stays continuous.
+processBool() - naive digital output (true for the first duty cycle fraction of each period), e.g. for a manual PWM output.
+
+Waveforms (all -1 to +1, starting at phase 0):
+PULSE - +1 for the first duty cycle fraction of the period, -1 for the rest (duty cycle 0.5 is a square wave)
+SAW - rising ramp
+TRIANGLE - rises for the first duty cycle fraction of the period, then falls (duty cycle 0.5 is symmetric)
 
 */
 
 #pragma once
 
 #include "au_config.h"
+#include <stddef.h>
 
 class RectangularWave
 {
 public:
+
+    enum class Waveform
+    {
+        PULSE,
+        SAW,
+        TRIANGLE
+    };
+
     struct Setup
     {
         sample_t sample_rate_hz;
         sample_t frequency_hz;
         sample_t duty_cycle;        //Between 0 and 1
+        Waveform waveform = Waveform::PULSE;
     };
 
     void setup(Setup setup_config)
     {
-        m_period_samples = setup_config.sample_rate_hz / setup_config.frequecy_hz;
-        m_duty_cycle_samples = setup_config.duty_cycle * m_period_samples;
+        m_sample_rate = setup_config.sample_rate_hz;
+        m_waveform = setup_config.waveform;
+        setFrequency(setup_config.frequency_hz);
+        setDutyCycle(setup_config.duty_cycle);
+    }
+
+    /*
+    Set the frequency, keeping the current phase. Limited to below Nyquist.
+    */
+    void setFrequency(sample_t frequency_hz)
+    {
+        m_phase_increment = phaseIncrement(frequency_hz);
     }
 
     /*
-     * Call once per sample for a floating point output (-1 or 1) is required (for audio).
+    Set the duty cycle (0 - 1), keeping the current phase. processBool() uses it as is, so 0 and 1 give a constant low or high
+    output. The band-limited output limits it to 0.001 - 0.999, as each edge needs room for its correction.
+    */
+    void setDutyCycle(sample_t duty_cycle)
+    {
+        m_duty_cycle = auClamp(duty_cycle, 0.0f, 1.0f);
+        m_band_limited_duty_cycle = clampDutyCycle(duty_cycle);
+    }
+
+    void setWaveform(Waveform waveform)
+    {
+        m_waveform = waveform;
+    }
+
+    /*
+     * Call once per sample for a band-limited floating point output (-1 to 1), for audio.
      */
     sample_t process()
     {
-        return processBool() ? 1.0 : -1.0;
+        sample_t output_val = renderSample(m_phase, m_phase_increment, m_band_limited_duty_cycle);
+        advancePhase(m_phase_increment);
+        return output_val;
+    }
+
+    /*
+    Render a block of band-limited output at the current frequency and duty cycle.
+    */
+    void processBlock(sample_t* output_buffer, size_t num_samples)
+    {
+        processBlock(output_buffer, num_samples, nullptr, nullptr);
+    }
+
+    /*
+    Render a block of band-limited output with per sample frequency and/or duty cycle modulation.
+
+    Parameters:
+    frequency_hz_buffer - frequency for each sample, or nullptr to use the current frequency
+    duty_cycle_buffer - duty cycle for each sample, or nullptr to use the current duty cycle
+    */
+    void processBlock(sample_t* output_buffer, size_t num_samples, const sample_t* frequency_hz_buffer, const sample_t* duty_cycle_buffer)
+    {
+        sample_t phase = m_phase;
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            sample_t phase_increment = frequency_hz_buffer != nullptr ? phaseIncrement(frequency_hz_buffer[i]) : m_phase_increment;
+            sample_t duty_cycle = duty_cycle_buffer != nullptr ? clampDutyCycle(duty_cycle_buffer[i]) : m_band_limited_duty_cycle;
+            output_buffer[i] = renderSample(phase, phase_increment, duty_cycle);
+            phase += phase_increment;
+            if (phase >= 1.0f)
+            {
+                phase -= 1.0f;
+            }
+        }
+        m_phase = phase;
     }
 
     /*
@@ -42,20 +122,116 @@ public:
      */
     bool processBool()
     {
-        if (m_current_cycle_samples > m_period_samples)
+        bool output_val = m_phase < m_duty_cycle;
+        advancePhase(m_phase_increment);
+        return output_val;
+    }
+
+    /*
+    Restart the waveform from phase 0.
+    */
+    void resetPhase()
+    {
+        m_phase = 0;
+    }
+
+private:
+
+    sample_t phaseIncrement(sample_t frequency_hz)
+    {
+        sample_t phase_increment = frequency_hz / m_sample_rate;
+        return auClamp(phase_increment, 0.0f, 0.499f);
+    }
+
+    static sample_t clampDutyCycle(sample_t duty_cycle)
+    {
+        return auClamp(duty_cycle, 0.001f, 0.999f);
+    }
+
+    void advancePhase(sample_t phase_increment)
+    {
+        m_phase += phase_increment;
+        if (m_phase >= 1.0f)
         {
-            m_current_cycle_samples -= m_current_cycle_samples;
+            m_phase -= 1.0f;
         }
+    }
 
-        bool output_val = m_current_cycle_samples <= m_duty_cycle_samples;
-        m_current_cycle_samples += 1.0;
-        return output_val;
+    /*
+    PolyBLEP residual for a unit upward step at phase 0 (bandlimited step minus naive step).
+
+    Parameters:
+    phase - phase since the step (0 - 1)
+    phase_increment - phase change per sample
+    */
+    static sample_t polyBlep(sample_t phase, sample_t phase_increment)
+    {
+        if (phase < phase_increment)
+        {
+            sample_t x = 1.0f - (phase / phase_increment);
+            return -0.5f * x * x;
+        }
+        if (phase > 1.0f - phase_increment)
+        {
+            sample_t x = 1.0f + ((phase - 1.0f) / phase_increment);
+            return 0.5f * x * x;
+        }
+        return 0.0f;
     }
 
-private:
-    sample_t m_duty_cycle_samples;
-    sample_t m_period_samples;
-    sample_t m_current_cycle_samples = 1.0; // Stores position within current cycle of waveforn in samples
+    /*
+    PolyBLAMP residual for a unit increase in slope (per sample) at phase 0, i.e. the integral of the PolyBLEP residual.
+    */
+    static sample_t polyBlamp(sample_t phase, sample_t phase_increment)
+    {
+        if (phase < phase_increment)
+        {
+            sample_t x = 1.0f - (phase / phase_increment);
+            return x * x * x * (1.0f / 6.0f);
+        }
+        if (phase > 1.0f - phase_increment)
+        {
+            sample_t x = 1.0f + ((phase - 1.0f) / phase_increment);
+            return x * x * x * (1.0f / 6.0f);
+        }
+        return 0.0f;
+    }
+
+    sample_t renderSample(sample_t phase, sample_t phase_increment, sample_t duty_cycle)
+    {
+        //Phase since the discontinuity at the duty cycle point
+        sample_t duty_phase = phase - duty_cycle;
+        if (duty_phase < 0)
+        {
+            duty_phase += 1.0f;
+        }
 
+        switch (m_waveform)
+        {
+        case Waveform::SAW:
+            return (2.0f * phase) - 1.0f - (2.0f * polyBlep(phase, phase_increment));
+
+        case Waveform::TRIANGLE:
+        {
+            sample_t naive = phase < duty_cycle ? -1.0f + (2.0f * phase / duty_cycle)
+                                                : 1.0f - (2.0f * duty_phase / (1.0f - duty_cycle));
+            //Slope changes by +slope_change at phase 0 and -slope_change at the duty cycle point (per cycle)
+            sample_t slope_change = (2.0f / duty_cycle) + (2.0f / (1.0f - duty_cycle));
+            return naive + (slope_change * phase_increment * (polyBlamp(phase, phase_increment) - polyBlamp(duty_phase, phase_increment)));
+        }
+
+        default:
+        {
+            sample_t naive = phase < duty_cycle ? 1.0f : -1.0f;
+            return naive + (2.0f * polyBlep(phase, phase_increment)) - (2.0f * polyBlep(duty_phase, phase_increment));
+        }
+        }
+    }
 
-};
\ No newline at end of file
+    sample_t m_sample_rate = 48000;
+    sample_t m_phase_increment = 0;
+    sample_t m_duty_cycle = 0.5f;               //0 - 1, for processBool()
+    sample_t m_band_limited_duty_cycle = 0.5f;  //0.001 - 0.999, for the band-limited output
+    sample_t m_phase = 0; // Position within current cycle of waveform, 0 - 1
+    Waveform m_waveform = Waveform::PULSE;
+};
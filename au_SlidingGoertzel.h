@@ -0,0 +1,197 @@
+/*
+
+au_SlidingGoertzel.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Sliding DFT version of the Goertzel algorithm. The bin is updated in O(1) per sample over a window of the most recent samples
+(held in a DelayLine), so a result is available every hop rather than once per non-overlapping window like RealtimeGoertzel.
+
+Per sample: X(n) = x(n) + z * X(n-1) - z^N * x(n-N), where z = r * e^(-j * omega) and N is the window length.
+
+Numerical stability: the recurrence has its pole on the unit circle, so rounding errors are never forgotten. The state and
+twiddle factors are kept in double precision, which keeps the accumulated error below float resolution for runs of many hours.
+For unbounded runs a damping factor r slightly below 1 (e.g. 0.99999) can be set with setDamping(), which makes rounding errors
+decay at the cost of exponentially weighting the window (oldest sample scaled by r^N).
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_DelayLine.h"
+#include "au_GoertzelAlgorithm.h"
+#include <math.h>
+#include <stddef.h>
+
+template<unsigned long max_window_length>
+class SlidingGoertzel
+{
+public:
+
+    SlidingGoertzel()
+    {
+        reset();
+    }
+
+    /*
+    Uses the same parameters as GoertzelAlgorithm. The window length (target period * window_size_periods) is limited to max_window_length.
+    */
+    void setup(const GoertzelAlgorithm::SetupParameters& setup_parameters)
+    {
+        m_sample_rate = setup_parameters.sample_rate;
+        m_window_size_periods = setup_parameters.window_size_periods;
+        m_target_frequency = setup_parameters.target_frequency;
+        recalcCoefficients();
+    }
+
+    void setTargetFrequencyHz(sample_t target_frequency_hz)
+    {
+        m_target_frequency = target_frequency_hz;
+        recalcCoefficients();
+    }
+
+    void setWindowSizePeriods(int window_size_periods)
+    {
+        m_window_size_periods = window_size_periods;
+        recalcCoefficients();
+    }
+
+    /*
+    Set how often (in samples) a new result is latched and the new value flag is set. The bin itself is updated every sample.
+    */
+    void setHopSamples(unsigned long hop_samples)
+    {
+        m_hop_samples = hop_samples > 0 ? hop_samples : 1;
+    }
+
+    /*
+    Set the damping factor r (0 < r <= 1). Defaults to 1 (no damping).
+    */
+    void setDamping(double damping)
+    {
+        m_damping = damping;
+        recalcCoefficients();
+    }
+
+    unsigned long getWindowLengthSamples()
+    {
+        return m_window_length_samples;
+    }
+
+    void processSample(sample_t new_sample)
+    {
+        sample_t oldest_sample = m_window.step(new_sample);
+
+        double real = new_sample + (m_twiddle_real * m_real) - (m_twiddle_imaginary * m_imaginary) - (m_twiddle_n_real * oldest_sample);
+        double imaginary = (m_twiddle_real * m_imaginary) + (m_twiddle_imaginary * m_real) - (m_twiddle_n_imaginary * oldest_sample);
+        m_real = real;
+        m_imaginary = imaginary;
+
+        if (m_samples_in_window < m_window_length_samples)
+        {
+            m_samples_in_window++;
+        }
+
+        if (++m_samples_since_hop >= m_hop_samples && m_samples_in_window == m_window_length_samples)
+        {
+            m_samples_since_hop = 0;
+            m_last_real = m_real;
+            m_last_imaginary = m_imaginary;
+            m_new_val_flag = true;
+        }
+    }
+
+    void processBlock(const sample_t* buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            processSample(buffer[i]);
+        }
+    }
+
+    /*
+    Get the magnitude of the window at the last hop. Matches the magnitude from GoertzelAlgorithm for the same window.
+    */
+    sample_t getLastMagnitude()
+    {
+        return sqrt((m_last_real * m_last_real) + (m_last_imaginary * m_last_imaginary));
+    }
+
+    /*
+    Get the magnitude and phase of the window at the last hop. Phase is in the range -PI to PI, relative to the newest sample in the window.
+    */
+    GoertzelAlgorithm::ComplexPolarForm getLastComplexMagnitudeAndPhase()
+    {
+        GoertzelAlgorithm::ComplexPolarForm mag_and_phase;
+        mag_and_phase.magnitude = getLastMagnitude();
+        mag_and_phase.phase = atan2(m_last_imaginary, m_last_real);
+        return mag_and_phase;
+    }
+
+    /*
+     * Returns true if a new hop val is available since last flag check, false if not
+     */
+    bool checkNewValFlag()
+    {
+        bool flag_state = m_new_val_flag;
+        m_new_val_flag = false;
+        return flag_state;
+    }
+
+    /*
+    Clear the window and the bin. A new result is available once the window has been filled again.
+    */
+    void reset()
+    {
+        m_window.clear();
+        m_window.setDelayLength(m_window_length_samples);
+        m_real = 0;
+        m_imaginary = 0;
+        m_samples_in_window = 0;
+        m_samples_since_hop = 0;
+    }
+
+private:
+
+    void recalcCoefficients()
+    {
+        unsigned long window_length = static_cast<unsigned long>(m_window_size_periods * (m_sample_rate / m_target_frequency));
+        if (window_length > max_window_length)
+        {
+            window_length = max_window_length;
+        }
+        m_window_length_samples = window_length > 0 ? window_length : 1;
+
+        double omega = (2.0 * M_PI * m_target_frequency) / m_sample_rate;
+        m_twiddle_real = m_damping * cos(omega);
+        m_twiddle_imaginary = -m_damping * sin(omega);
+
+        double damping_n = pow(m_damping, static_cast<double>(m_window_length_samples));
+        m_twiddle_n_real = damping_n * cos(omega * m_window_length_samples);
+        m_twiddle_n_imaginary = -damping_n * sin(omega * m_window_length_samples);
+        reset();
+    }
+
+    DelayLine<sample_t, max_window_length> m_window;
+
+    double m_real, m_imaginary;
+    double m_last_real = 0;
+    double m_last_imaginary = 0;
+    double m_twiddle_real = 1;
+    double m_twiddle_imaginary = 0;
+    double m_twiddle_n_real = 1;
+    double m_twiddle_n_imaginary = 0;
+    double m_damping = 1.0;
+
+    int m_sample_rate = 1;
+    int m_window_size_periods = 1;
+    sample_t m_target_frequency = 1;
+
+    unsigned long m_window_length_samples = 1;
+    unsigned long m_samples_in_window = 0;
+    unsigned long m_hop_samples = 1;
+    unsigned long m_samples_since_hop = 0;
+    bool m_new_val_flag = false;
+};
@@ -0,0 +1,310 @@
+/*
+
+au_SmoothedParameter.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Block rate parameter smoothing, to avoid zipper noise when a parameter (level, cutoff, frequency...) changes.
+
+Instead of running a smoothing filter on every parameter every sample, SmoothedParameter knows when it has settled on its
+target and does no work at all until the target changes again. While it is moving it renders a whole block of ramp values at
+once (vectorised), which processors with per sample parameter buffers can take directly.
+
+Ramp types:
+ONE_POLE - exponential approach, identical in response to an Onepole smoother (see BasicOnepole::setTimeConstant()). Ramp time
+    is the time constant (63% of the change). The ramp is treated as settled, and snaps to the target, once within 0.01% (-80dB)
+    of the change, which takes about 9.2 time constants.
+LINEAR - constant rate, reaching the target exactly after the ramp time.
+
+Usage, with a processor that takes optional per sample parameter buffers:
+    frequency.setTarget(new_frequency_hz);
+    wave.setFrequency(new_frequency_hz);                    //Used once the ramp has settled
+    ...
+    //Ramp buffer while moving, nullptr (no per sample work) once settled
+    wave.processBlock(output, num_samples, frequency.processBlock(ramp_buffer, num_samples), nullptr);
+
+Or for a gain:
+    level.applyGain(output, num_samples);
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_Onepole.h"
+#include <math.h>
+#include <stddef.h>
+
+class SmoothedParameter
+{
+public:
+
+    enum class RampType
+    {
+        ONE_POLE,
+        LINEAR
+    };
+
+    struct Setup
+    {
+        sample_t sample_rate_hz;
+        sample_t ramp_time_s;                           //Time constant for ONE_POLE, ramp length for LINEAR. 0 for no smoothing
+        RampType ramp_type = RampType::ONE_POLE;
+        sample_t initial_value = 0;
+    };
+
+    void setup(Setup setup_config)
+    {
+        m_sample_rate = setup_config.sample_rate_hz;
+        m_ramp_type = setup_config.ramp_type;
+        setRampTime(setup_config.ramp_time_s);
+        reset(setup_config.initial_value);
+    }
+
+    /*
+    Set the ramp time (see Setup). Applies from the next setTarget(); a ramp in progress continues unchanged.
+    */
+    void setRampTime(sample_t ramp_time_s)
+    {
+        double ramp_samples = static_cast<double>(ramp_time_s) * m_sample_rate;
+        if (m_ramp_type == RampType::LINEAR)
+        {
+            m_ramp_samples = ramp_samples > 0 ? static_cast<size_t>(ramp_samples + 0.5) : 0;
+            return;
+        }
+
+        //Decay per sample of the distance to the target, as Onepole: remaining = r^n
+        double r = -static_cast<double>(Onepole::timeConstantToB1(ramp_time_s, m_sample_rate));
+        m_ramp_samples = r > 0 ? static_cast<size_t>(ceil(log(SETTLE_RATIO) / log(r))) : 0;
+        m_ramp_decay = static_cast<sample_t>(r);
+        double power = 1.0;
+        for (size_t i = 0 ; i < CHUNK_SIZE ; i++)
+        {
+            power *= r;
+            m_ramp_decay_powers[i] = static_cast<sample_t>(power);
+        }
+    }
+
+    /*
+    Start ramping from the current value to a new target. Does nothing if target is already the target.
+    */
+    void setTarget(sample_t target)
+    {
+        if (target == m_target)
+        {
+            return;
+        }
+        m_target = target;
+        m_samples_remaining = m_ramp_samples;
+        if (m_samples_remaining == 0)
+        {
+            m_current = target;
+            return;
+        }
+        m_increment = (m_target - m_current) / static_cast<sample_t>(m_samples_remaining);
+        m_decay = m_ramp_decay;
+        for (size_t i = 0 ; i < CHUNK_SIZE ; i++)
+        {
+            m_decay_powers[i] = m_ramp_decay_powers[i];
+        }
+    }
+
+    /*
+    Jump straight to value, ending any ramp.
+    */
+    void reset(sample_t value)
+    {
+        m_current = value;
+        m_target = value;
+        m_samples_remaining = 0;
+    }
+
+    sample_t getTarget() const
+    {
+        return m_target;
+    }
+
+    sample_t getCurrentValue() const
+    {
+        return m_current;
+    }
+
+    /*
+    Return: true while ramping, false once settled on the target.
+    */
+    bool isSmoothing() const
+    {
+        return m_samples_remaining > 0;
+    }
+
+    /*
+    Advance by one sample, for per sample use.
+    Return: the smoothed value for this sample.
+    */
+    sample_t getNextValue()
+    {
+        if (m_samples_remaining == 0)
+        {
+            return m_current;
+        }
+        if (--m_samples_remaining == 0)
+        {
+            m_current = m_target;
+        }
+        else if (m_ramp_type == RampType::LINEAR)
+        {
+            m_current += m_increment;
+        }
+        else
+        {
+            m_current = m_target + ((m_current - m_target) * m_decay);
+        }
+        return m_current;
+    }
+
+    /*
+    Advance by a block. While ramping, fills ramp_buffer with the smoothed value for each sample (the same values as calling
+    getNextValue() num_samples times, to float rounding). Once settled, does nothing.
+
+    Parameters:
+    ramp_buffer - at least num_samples long, or nullptr to just advance the ramp
+
+    Return: ramp_buffer if the value moved during the block, or nullptr if it was settled on getCurrentValue() for the whole
+    block or num_samples is 0 (so processors taking nullable per sample buffers fall back to their static value).
+    */
+    const sample_t* processBlock(sample_t* ramp_buffer, size_t num_samples)
+    {
+        if (m_samples_remaining == 0 || num_samples == 0)
+        {
+            return nullptr;
+        }
+        if (ramp_buffer == nullptr)
+        {
+            skip(num_samples);
+            return nullptr;
+        }
+
+        size_t ramp_length = num_samples < m_samples_remaining ? num_samples : m_samples_remaining;
+        if (m_ramp_type == RampType::LINEAR)
+        {
+            renderLinearRamp(ramp_buffer, ramp_length);
+        }
+        else
+        {
+            renderOnePoleRamp(ramp_buffer, ramp_length);
+        }
+        m_samples_remaining -= ramp_length;
+
+        if (m_samples_remaining == 0)
+        {
+            m_current = m_target;
+            ramp_buffer[ramp_length - 1] = m_target;
+            for (size_t i = ramp_length ; i < num_samples ; i++)
+            {
+                ramp_buffer[i] = m_target;
+            }
+        }
+        return ramp_buffer;
+    }
+
+    /*
+    Multiply buffer by the smoothed value, as a gain. Costs nothing once settled on a gain of 1, and one (vectorised) multiply per
+    sample once settled on any other gain.
+    */
+    void applyGain(sample_t* buffer, size_t num_samples)
+    {
+        size_t done = 0;
+        while (m_samples_remaining > 0 && done < num_samples)
+        {
+            size_t chunk_length = num_samples - done < CHUNK_SIZE ? num_samples - done : CHUNK_SIZE;
+            sample_t gains[CHUNK_SIZE];
+            processBlock(gains, chunk_length);
+            for (size_t i = 0 ; i < chunk_length ; i++)
+            {
+                buffer[done + i] *= gains[i];
+            }
+            done += chunk_length;
+        }
+
+        if (m_current != 1.0f)
+        {
+            sample_t gain = m_current;
+            for (size_t i = done ; i < num_samples ; i++)
+            {
+                buffer[i] *= gain;
+            }
+        }
+    }
+
+    /*
+    Advance by num_samples without rendering the ramp, e.g. while a processor is bypassed.
+    */
+    void skip(size_t num_samples)
+    {
+        if (num_samples >= m_samples_remaining)
+        {
+            m_samples_remaining = 0;
+            m_current = m_target;
+            return;
+        }
+        m_samples_remaining -= num_samples;
+        if (m_ramp_type == RampType::LINEAR)
+        {
+            m_current += m_increment * static_cast<sample_t>(num_samples);
+        }
+        else
+        {
+            m_current = m_target + ((m_current - m_target) * static_cast<sample_t>(pow(m_decay, static_cast<double>(num_samples))));
+        }
+    }
+
+private:
+
+    //Ramps are rendered in chunks of this many samples, each from a closed form, so there's no loop carried dependency
+    static constexpr size_t CHUNK_SIZE = 16;
+    static constexpr double SETTLE_RATIO = 1e-4; //-80dB
+
+    void renderLinearRamp(sample_t* ramp_buffer, size_t ramp_length)
+    {
+        sample_t start = m_current;
+        sample_t increment = m_increment;
+        //int index, as size_t to float conversions don't vectorise
+        int length = static_cast<int>(ramp_length);
+        for (int i = 0 ; i < length ; i++)
+        {
+            ramp_buffer[i] = start + (increment * static_cast<sample_t>(i + 1));
+        }
+        m_current = ramp_buffer[ramp_length - 1];
+    }
+
+    void renderOnePoleRamp(sample_t* ramp_buffer, size_t ramp_length)
+    {
+        sample_t target = m_target;
+        sample_t distance = m_current - target;
+        for (size_t start = 0 ; start < ramp_length ; start += CHUNK_SIZE)
+        {
+            size_t chunk_length = ramp_length - start < CHUNK_SIZE ? ramp_length - start : CHUNK_SIZE;
+            sample_t* chunk = ramp_buffer + start;
+            for (size_t i = 0 ; i < chunk_length ; i++)
+            {
+                chunk[i] = target + (distance * m_decay_powers[i]);
+            }
+            distance *= m_decay_powers[chunk_length - 1];
+        }
+        m_current = target + distance;
+    }
+
+    sample_t m_sample_rate = 48000;
+    RampType m_ramp_type = RampType::ONE_POLE;
+    size_t m_ramp_samples = 0;                          //Length of a ramp, to settled for ONE_POLE
+    sample_t m_ramp_decay = 0;                          //ONE_POLE decay for the next ramp, from setRampTime()
+    sample_t m_ramp_decay_powers[CHUNK_SIZE] = {};
+    sample_t m_decay = 0;                               //ONE_POLE distance to target multiplier per sample, this ramp
+    sample_t m_decay_powers[CHUNK_SIZE] = {};           //m_decay^1 to m_decay^CHUNK_SIZE
+
+    sample_t m_current = 0;
+    sample_t m_target = 0;
+    sample_t m_increment = 0;                           //LINEAR change per sample
+    size_t m_samples_remaining = 0;
+};
@@ -0,0 +1,214 @@
+/*
+
+au_SpscCircularBuffer.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Lock-free single producer/single consumer version of CircularBuffer, for passing audio between e.g. an I/O or network thread
+and the audio thread without a mutex.
+
+- One thread may write and one (other) thread may read at the same time. Neither ever blocks or waits.
+- Unlike CircularBuffer, a full buffer rejects writes rather than overwriting unread data (which would race with the reader).
+- Read/write positions run over [0, 2 * buffer_length) on separate cache lines, so full and empty can be told apart and any
+  buffer length wraps correctly (a free running counter modulo a non power of two length would jump when the counter wraps).
+  Each side keeps a cached copy of the other side's position on its own cache line, so the shared positions are only loaded
+  when the cached copy says the buffer is full/empty.
+- Overrun/underrun flags are atomic and can be checked from any thread. Checking is wait-free.
+- Bulk write()/read() move a whole block per synchronisation.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+
+template<typename T, unsigned long buffer_length>
+class SpscCircularBuffer
+{
+public:
+
+    static_assert(buffer_length > 0, "Buffer length must be greater than 0");
+
+    /*
+    Producer: write a single value.
+
+    Return: false if the buffer is full (value is discarded and the overrun flag is set)
+    */
+    bool write(const T& new_buffer_val)
+    {
+        size_t write_position = m_write_position.load(std::memory_order_relaxed);
+        if (distance(m_cached_read_position, write_position) >= buffer_length)
+        {
+            m_cached_read_position = m_read_position.load(std::memory_order_acquire);
+            if (distance(m_cached_read_position, write_position) >= buffer_length)
+            {
+                m_overrun.store(true, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_buffer[bufferIndex(write_position)] = new_buffer_val;
+        m_write_position.store(advance(write_position, 1), std::memory_order_release);
+        return true;
+    }
+
+    /*
+    Producer: write a block of values.
+
+    Return: number of values written. If less than num_values, the buffer was full and the overrun flag is set.
+    */
+    size_t write(const T* values, size_t num_values)
+    {
+        size_t write_position = m_write_position.load(std::memory_order_relaxed);
+        size_t space = buffer_length - distance(m_cached_read_position, write_position);
+        if (space < num_values)
+        {
+            m_cached_read_position = m_read_position.load(std::memory_order_acquire);
+            space = buffer_length - distance(m_cached_read_position, write_position);
+        }
+        size_t num_to_write = num_values < space ? num_values : space;
+
+        size_t start = bufferIndex(write_position);
+        size_t first_part = (buffer_length - start) < num_to_write ? (buffer_length - start) : num_to_write;
+        for (size_t i = 0 ; i < first_part ; i++)
+        {
+            m_buffer[start + i] = values[i];
+        }
+        for (size_t i = first_part ; i < num_to_write ; i++)
+        {
+            m_buffer[i - first_part] = values[i];
+        }
+        m_write_position.store(advance(write_position, num_to_write), std::memory_order_release);
+
+        if (num_to_write < num_values)
+        {
+            m_overrun.store(true, std::memory_order_relaxed);
+        }
+        return num_to_write;
+    }
+
+    /*
+    Consumer: read a single value.
+
+    Return: false if the buffer is empty (read_val is unchanged and the underrun flag is set)
+    */
+    bool read(T& read_val)
+    {
+        size_t read_position = m_read_position.load(std::memory_order_relaxed);
+        if (read_position == m_cached_write_position)
+        {
+            m_cached_write_position = m_write_position.load(std::memory_order_acquire);
+            if (read_position == m_cached_write_position)
+            {
+                m_underrun.store(true, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        read_val = m_buffer[bufferIndex(read_position)];
+        m_read_position.store(advance(read_position, 1), std::memory_order_release);
+        return true;
+    }
+
+    /*
+    Consumer: read a block of values.
+
+    Return: number of values read. If less than num_values, the buffer ran empty and the underrun flag is set.
+    */
+    size_t read(T* values, size_t num_values)
+    {
+        size_t read_position = m_read_position.load(std::memory_order_relaxed);
+        size_t available = distance(read_position, m_cached_write_position);
+        if (available < num_values)
+        {
+            m_cached_write_position = m_write_position.load(std::memory_order_acquire);
+            available = distance(read_position, m_cached_write_position);
+        }
+        size_t num_to_read = num_values < available ? num_values : available;
+
+        size_t start = bufferIndex(read_position);
+        size_t first_part = (buffer_length - start) < num_to_read ? (buffer_length - start) : num_to_read;
+        for (size_t i = 0 ; i < first_part ; i++)
+        {
+            values[i] = m_buffer[start + i];
+        }
+        for (size_t i = first_part ; i < num_to_read ; i++)
+        {
+            values[i] = m_buffer[i - first_part];
+        }
+        m_read_position.store(advance(read_position, num_to_read), std::memory_order_release);
+
+        if (num_to_read < num_values)
+        {
+            m_underrun.store(true, std::memory_order_relaxed);
+        }
+        return num_to_read;
+    }
+
+    /*
+    Returns true if a write was rejected since the last call. Can be called from any thread.
+    */
+    bool overRun()
+    {
+        return m_overrun.exchange(false, std::memory_order_relaxed);
+    }
+
+    /*
+    Returns true if a read found the buffer empty since the last call. Can be called from any thread.
+    */
+    bool underRun()
+    {
+        return m_underrun.exchange(false, std::memory_order_relaxed);
+    }
+
+    /*
+    Number of items in the buffer. Exact when called from the producer or consumer thread while the other side is idle,
+    otherwise a snapshot that may already be out of date.
+    */
+    long itemsInBuffer()
+    {
+        size_t read_position = m_read_position.load(std::memory_order_acquire);
+        size_t write_position = m_write_position.load(std::memory_order_acquire);
+        return static_cast<long>(distance(read_position, write_position));
+    }
+
+private:
+
+    static constexpr size_t POSITION_RANGE = 2 * static_cast<size_t>(buffer_length);
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    static size_t bufferIndex(size_t position)
+    {
+        return position < buffer_length ? position : position - buffer_length;
+    }
+
+    /*
+    Move a position on by num_items (at most buffer_length), wrapping at POSITION_RANGE.
+    */
+    static size_t advance(size_t position, size_t num_items)
+    {
+        position += num_items;
+        return position >= POSITION_RANGE ? position - POSITION_RANGE : position;
+    }
+
+    /*
+    Return: number of items from position from up to position to, 0 to buffer_length.
+    */
+    static size_t distance(size_t from, size_t to)
+    {
+        return to >= from ? to - from : to + POSITION_RANGE - from;
+    }
+
+    //Producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_write_position{0};
+    size_t m_cached_read_position = 0;
+
+    //Consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_read_position{0};
+    size_t m_cached_write_position = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> m_overrun{false};
+    std::atomic<bool> m_underrun{false};
+
+    alignas(CACHE_LINE_SIZE) T m_buffer[buffer_length];
+};
@@ -0,0 +1,275 @@
+/*
+
+au_Stft.h
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Short-time Fourier transform framing and overlap-add resynthesis.
+
+StftFramer - accepts input in blocks of any size and calls frameReady() with a windowed frame every hop_size samples.
+    Input history is stored mirrored (each sample written twice, frame_size apart) so the latest frame is always contiguous:
+    getLatestFrame() gives zero-copy access to it, and the only copy made is the one that applies the analysis window.
+
+OverlapAdd - windows processed frames with a synthesis window, overlap-adds them and queues finished samples in a CircularBuffer.
+    The sum of analysis x synthesis windows is normalised out, so unmodified frames reconstruct the input exactly.
+
+StftProcessor - StftFramer and OverlapAdd connected together. Override processFrame() to modify each frame (e.g. FFT, spectral
+    processing, inverse FFT). Output is the input delayed by exactly frame_size samples (getLatencySamples()).
+
+Frames are set up and windowed using Windowing, so window tables are shared with any other users of the same window.
+
+*/
+
+#pragma once
+
+#include "au_config.h"
+#include "au_CircularBuffer.h"
+#include "au_Windowing.h"
+#include <stddef.h>
+
+template<unsigned int frame_size, unsigned int hop_size>
+class StftFramer
+{
+public:
+
+    static_assert(hop_size > 0 && hop_size <= frame_size, "Hop size must be between 1 and the frame size");
+
+    StftFramer(Windowing::WindowType window_type = Windowing::WindowType::HANN) : m_window(window_type, frame_size)
+    {
+        reset();
+    }
+
+    virtual ~StftFramer() {}
+
+    void setWindowType(Windowing::WindowType window_type)
+    {
+        m_window.setWindowType(window_type);
+    }
+
+    /*
+    Push a block of input samples of any size. frameReady() is called (from within this function) for every completed frame.
+    */
+    void process(const sample_t* input_buffer, size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t samples_to_frame = hop_size - m_samples_since_frame;
+            size_t chunk = (num_samples - i) < samples_to_frame ? (num_samples - i) : samples_to_frame;
+            pushSamples(&input_buffer[i], chunk);
+            i += chunk;
+        }
+    }
+
+    /*
+    Zero-copy access to the most recent frame_size input samples (unwindowed, oldest first).
+    */
+    const sample_t* getLatestFrame()
+    {
+        return &m_history[m_write_index];
+    }
+
+    void reset()
+    {
+        for (unsigned int i = 0 ; i < 2 * frame_size ; i++)
+        {
+            m_history[i] = 0;
+        }
+        m_write_index = 0;
+        m_samples_since_frame = 0;
+    }
+
+protected:
+
+    /*
+    Called every hop_size input samples with the windowed frame (frame_size samples, oldest first).
+    The frame buffer can be modified in place.
+    */
+    virtual void frameReady(sample_t* /*windowed_frame*/) {}
+
+    /*
+    Push samples up to (and including) the next frame boundary.
+    */
+    void pushSamples(const sample_t* input_buffer, size_t num_samples)
+    {
+        for (size_t i = 0 ; i < num_samples ; i++)
+        {
+            m_history[m_write_index] = input_buffer[i];
+            m_history[m_write_index + frame_size] = input_buffer[i];
+            if (++m_write_index == frame_size)
+            {
+                m_write_index = 0;
+            }
+        }
+        m_samples_since_frame += num_samples;
+        if (m_samples_since_frame == hop_size)
+        {
+            m_samples_since_frame = 0;
+            m_window.applyWindowToBuffer(getLatestFrame(), m_frame);
+            frameReady(m_frame);
+        }
+    }
+
+    unsigned int samplesToNextFrame()
+    {
+        return hop_size - m_samples_since_frame;
+    }
+
+private:
+    Windowing m_window;
+    sample_t m_history[2 * frame_size];
+    sample_t m_frame[frame_size];
+    unsigned int m_write_index;
+    unsigned int m_samples_since_frame;
+};
+
+
+template<unsigned int frame_size, unsigned int hop_size>
+class OverlapAdd
+{
+public:
+
+    static_assert(frame_size % hop_size == 0, "Frame size must be a multiple of the hop size");
+
+    /*
+    Parameters:
+    synthesis_window_type - window applied to each frame before overlap-adding
+    analysis_window_type - window the frames were analysed with, used to normalise the output
+    */
+    OverlapAdd(Windowing::WindowType synthesis_window_type = Windowing::WindowType::HANN,
+               Windowing::WindowType analysis_window_type = Windowing::WindowType::HANN)
+        : m_synthesis_window(synthesis_window_type, frame_size)
+    {
+        Windowing analysis_window(analysis_window_type, frame_size);
+        const sample_t* analysis = analysis_window.getWindowTable();
+        const sample_t* synthesis = m_synthesis_window.getWindowTable();
+        for (unsigned int n = 0 ; n < hop_size ; n++)
+        {
+            double window_sum = 0;
+            for (unsigned int i = n ; i < frame_size ; i += hop_size)
+            {
+                window_sum += analysis[i] * synthesis[i];
+            }
+            m_inverse_window_sum[n] = window_sum > 1e-9 ? 1.0 / window_sum : 0.0;
+        }
+        reset();
+    }
+
+    /*
+    Add a frame (frame_size samples, oldest first) to the output. hop_size output samples become available for each frame added.
+    */
+    void addFrame(const sample_t* frame)
+    {
+        const sample_t* synthesis = m_synthesis_window.getWindowTable();
+
+        //Accumulator is a ring starting at m_accumulator_index, add in two contiguous parts
+        unsigned int first_part = frame_size - m_accumulator_index;
+        for (unsigned int i = 0 ; i < first_part ; i++)
+        {
+            m_accumulator[m_accumulator_index + i] += frame[i] * synthesis[i];
+        }
+        for (unsigned int i = first_part ; i < frame_size ; i++)
+        {
+            m_accumulator[i - first_part] += frame[i] * synthesis[i];
+        }
+
+        //Oldest hop is now complete
+        for (unsigned int n = 0 ; n < hop_size ; n++)
+        {
+            m_output.write(m_accumulator[m_accumulator_index + n] * m_inverse_window_sum[n]);
+            m_accumulator[m_accumulator_index + n] = 0;
+        }
+        m_accumulator_index = (m_accumulator_index + hop_size) % frame_size;
+    }
+
+    /*
+    Read finished output samples. Must not read more samples than have been made available by addFrame().
+    */
+    void read(sample_t* output_buffer, size_t num_samples)
+    {
+        m_output.read(output_buffer, num_samples);
+    }
+
+    /*
+    Clear the output. One hop of silence is queued so that output can be read in step with input (see StftProcessor).
+    */
+    void reset()
+    {
+        for (unsigned int i = 0 ; i < frame_size ; i++)
+        {
+            m_accumulator[i] = 0;
+        }
+        m_accumulator_index = 0;
+        m_output.clear();
+        for (unsigned int n = 0 ; n < hop_size ; n++)
+        {
+            m_output.write(0);
+        }
+    }
+
+private:
+    Windowing m_synthesis_window;
+    sample_t m_accumulator[frame_size];
+    sample_t m_inverse_window_sum[hop_size];
+    unsigned int m_accumulator_index;
+    CircularBuffer<sample_t, 2 * hop_size> m_output;
+};
+
+
+template<unsigned int frame_size, unsigned int hop_size>
+class StftProcessor : public StftFramer<frame_size, hop_size>
+{
+public:
+
+    StftProcessor(Windowing::WindowType analysis_window_type = Windowing::WindowType::HANN,
+                  Windowing::WindowType synthesis_window_type = Windowing::WindowType::HANN)
+        : StftFramer<frame_size, hop_size>(analysis_window_type), m_overlap_add(synthesis_window_type, analysis_window_type)
+    {
+    }
+
+    /*
+    Process a block of any size. Output is the input (as modified by processFrame()) delayed by getLatencySamples().
+    Input and output can be the same buffer.
+    */
+    void process(const sample_t* input_buffer, sample_t* output_buffer, size_t num_samples)
+    {
+        size_t i = 0;
+        while (i < num_samples)
+        {
+            size_t samples_to_frame = this->samplesToNextFrame();
+            size_t chunk = (num_samples - i) < samples_to_frame ? (num_samples - i) : samples_to_frame;
+            this->pushSamples(&input_buffer[i], chunk);
+            m_overlap_add.read(&output_buffer[i], chunk);
+            i += chunk;
+        }
+    }
+
+    static constexpr unsigned int getLatencySamples()
+    {
+        return frame_size;
+    }
+
+    void reset()
+    {
+        StftFramer<frame_size, hop_size>::reset();
+        m_overlap_add.reset();
+    }
+
+protected:
+
+    /*
+    Override to modify each windowed frame in place before it is resynthesised. Default leaves the frame unchanged.
+    */
+    virtual void processFrame(sample_t* /*frame*/) {}
+
+private:
+
+    void frameReady(sample_t* windowed_frame) override
+    {
+        processFrame(windowed_frame);
+        m_overlap_add.addFrame(windowed_frame);
+    }
+
+    OverlapAdd<frame_size, hop_size> m_overlap_add;
+};
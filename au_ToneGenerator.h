@@ -10,6 +10,7 @@ Date: 22/01/2024
 #pragma once
 
 #include "au_config.h"
+#include "au_FastMath.h"
 #include <cmath>
 
 class ToneGenerator
@@ -41,12 +42,21 @@ public:
 
     void setLeveldB(sample_t level_db)
     {
-        m_level_lin = dBToLin(level_db);
+        m_level_lin = m_use_fast_math ? FastMath::dBToLin(level_db) : dBToLin(level_db);
+    }
+
+    /*
+    When enabled, uses FastMath (MEDIUM accuracy) instead of sinf() and pow(): sine error within 1.2e-6, level within 0.00005dB.
+    Call before setLeveldB() for it to apply to the level.
+    */
+    void setFastMath(bool use_fast_math)
+    {
+        m_use_fast_math = use_fast_math;
     }
 
     sample_t process()
     {
-        sample_t out = sinf(m_phase);
+        sample_t out = m_use_fast_math ? FastMath::sin(m_phase) : sinf(m_phase);
 		m_phase += 2.0f * (sample_t)M_PI * m_frequency * m_inverse_sample_rate;
 		if(m_phase > M_PI)
 			m_phase -= 2.0f * (sample_t)M_PI;
@@ -58,5 +68,6 @@ private:
     sample_t m_frequency = 0;
     sample_t m_inverse_sample_rate = 1.0;
     sample_t m_level_lin = 1.0;
+    bool m_use_fast_math = false;
 
-};
\ No newline at end of file
+};
@@ -11,6 +11,12 @@ Date: 24/12/2023
 
 #include "au_config.h"
 #include "math.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <tuple>
+#include <vector>
 
 class Windowing
 {
@@ -21,13 +27,23 @@ public:
     {
         HANN,
         HAMMING,
-        RECTANGULAR
+        RECTANGULAR,
+        BLACKMAN_HARRIS,    //4 term, -92dB sidelobes
+        KAISER,             //Shape set by setKaiserBeta()
+        FLAT_TOP            //For accurate amplitude measurement
     };
 
     Windowing(WindowType window_type = WindowType::HAMMING, int window_size_samples = 1);
 
     void setWindowSizeSamples(int window_size_samples);
 
+    void setWindowType(WindowType window_type);
+
+    /*
+    Set the beta parameter of the Kaiser window (higher = lower sidelobes, wider main lobe). Only used by WindowType::KAISER.
+    */
+    void setKaiserBeta(sample_t kaiser_beta);
+
     sample_t applyWindowToSample(sample_t sample);
     
 
@@ -53,28 +69,104 @@ public:
     */
     void applyWindowToBuffer(sample_t* sample_buffer);
 
+    /*
+    Apply windowing to a window-sized buffer, writing the result to a separate buffer.
+    */
+    void applyWindowToBuffer(const sample_t* input_buffer, sample_t* output_buffer);
+
+    /*
+    Get the window coefficients (window size samples long, 64 byte aligned).
+    */
+    const sample_t* getWindowTable();
+
     void resetIndex();
 
 private:
 
+    /*
+    Window coefficients are calculated once per (type, size, Kaiser beta) and shared between all instances with the same
+    configuration through a process wide cache. Tables are freed when the last instance using them changes or is destroyed.
+    Changing the window type or size looks up the cache under a mutex, so should not be done on a realtime thread.
+    */
+    struct WindowTable
+    {
+        static constexpr std::size_t ALIGNMENT = 64;
+
+        //Over allocated by up to ALIGNMENT bytes, coefficients points at the first aligned element (aligned operator new needs C++17)
+        explicit WindowTable(int window_size_samples) : storage(window_size_samples + (ALIGNMENT / sizeof(sample_t)))
+        {
+            uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+            size_t offset = ((ALIGNMENT - (address % ALIGNMENT)) % ALIGNMENT) / sizeof(sample_t);
+            coefficients = storage.data() + offset;
+        }
+        WindowTable(const WindowTable&) = delete;
+        WindowTable& operator=(const WindowTable&) = delete;
+
+        std::vector<sample_t> storage;
+        sample_t* coefficients;
+    };
+
+    static std::shared_ptr<const WindowTable> getCachedTable(WindowType window_type, int window_size_samples, sample_t kaiser_beta)
+    {
+        static std::mutex cache_mutex;
+        static std::map<std::tuple<WindowType, int, sample_t>, std::weak_ptr<const WindowTable>> cache;
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        std::tuple<WindowType, int, sample_t> key(window_type, window_size_samples, window_type == WindowType::KAISER ? kaiser_beta : 0);
+        std::shared_ptr<const WindowTable> table = cache[key].lock();
+        if (!table)
+        {
+            std::shared_ptr<WindowTable> new_table = std::make_shared<WindowTable>(window_size_samples);
+            for (int n = 0 ; n < window_size_samples ; n++)
+            {
+                new_table->coefficients[n] = calcWindowValue(window_type, n, window_size_samples, kaiser_beta);
+            }
+            cache[key] = new_table;
+            table = new_table;
+        }
+        return table;
+    }
+
+    static double calcWindowValue(WindowType window_type, int sample_number, int window_size_samples, double kaiser_beta);
+    static double besselI0(double x);
+
+    void updateTable();
+
     WindowType m_window_type;
     int m_window_size_samples;
     int m_sample_number = 0;
+    sample_t m_kaiser_beta = 8.6;
+
+    std::shared_ptr<const WindowTable> m_table;
 };
 
-Windowing::Windowing(WindowType window_type, int window_size_samples)
+inline Windowing::Windowing(WindowType window_type, int window_size_samples)
 {
     m_window_type = window_type;
     m_window_size_samples = window_size_samples;
+    updateTable();
 }
 
-void Windowing::setWindowSizeSamples(int window_size_samples)
+inline void Windowing::setWindowSizeSamples(int window_size_samples)
 {
     m_window_size_samples = window_size_samples;
+    updateTable();
     resetIndex();
 }
 
-sample_t Windowing::applyWindowToSample(sample_t sample)
+inline void Windowing::setWindowType(WindowType window_type)
+{
+    m_window_type = window_type;
+    updateTable();
+}
+
+inline void Windowing::setKaiserBeta(sample_t kaiser_beta)
+{
+    m_kaiser_beta = kaiser_beta;
+    updateTable();
+}
+
+inline sample_t Windowing::applyWindowToSample(sample_t sample)
 {
     sample_t windowed_sample = applyWindowToNumberedSample(sample, m_sample_number);
     if (++m_sample_number == m_window_size_samples)
@@ -84,28 +176,78 @@ sample_t Windowing::applyWindowToSample(sample_t sample)
     return windowed_sample;
 }
 
-sample_t Windowing::applyWindowToNumberedSample(sample_t sample, int sample_number)
+inline sample_t Windowing::applyWindowToNumberedSample(sample_t sample, int sample_number)
+{
+    return sample * m_table->coefficients[sample_number];
+}
+
+inline void Windowing::applyWindowToBuffer(sample_t* sample_buffer)
+{
+    applyWindowToBuffer(sample_buffer, sample_buffer);
+}
+
+inline void Windowing::applyWindowToBuffer(const sample_t* input_buffer, sample_t* output_buffer)
 {
-    switch (m_window_type)
+    const sample_t* window = m_table->coefficients;
+    for (int i = 0 ; i < m_window_size_samples ; i++ )
+    {
+        output_buffer[i] = input_buffer[i] * window[i];
+    }
+}
+
+inline const sample_t* Windowing::getWindowTable()
+{
+    return m_table->coefficients;
+}
+
+inline void Windowing::resetIndex()
+{
+    m_sample_number = 0;
+}
+
+inline void Windowing::updateTable()
+{
+    m_table = getCachedTable(m_window_type, m_window_size_samples, m_kaiser_beta);
+}
+
+inline double Windowing::calcWindowValue(WindowType window_type, int sample_number, int window_size_samples, double kaiser_beta)
+{
+    double x = 2 * M_PI * sample_number / window_size_samples;
+    switch (window_type)
     {
         case WindowType::HANN:
-            return sample * (0.5 - 0.35 * cos(2 * M_PI * sample_number / m_window_size_samples));
+            return 0.5 - 0.5 * cos(x);
         case WindowType::HAMMING:
-            return sample * ( 0.54 - 0.46 * cos(2 * M_PI * sample_number / m_window_size_samples));
+            return 0.54 - 0.46 * cos(x);
         case WindowType::RECTANGULAR:
-            return sample;
+            return 1.0;
+        case WindowType::BLACKMAN_HARRIS:
+            return 0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2 * x) - 0.01168 * cos(3 * x);
+        case WindowType::KAISER:
+        {
+            double position = (2.0 * sample_number / window_size_samples) - 1.0;
+            return besselI0(kaiser_beta * sqrt(1.0 - position * position)) / besselI0(kaiser_beta);
+        }
+        case WindowType::FLAT_TOP:
+            return 0.21557895 - 0.41663158 * cos(x) + 0.277263158 * cos(2 * x) - 0.083578947 * cos(3 * x) + 0.006947368 * cos(4 * x);
     }
+    return 1.0;
 }
 
-void Windowing::applyWindowToBuffer(sample_t* sample_buffer)
+//Zeroth order modified Bessel function of the first kind, used by the Kaiser window
+inline double Windowing::besselI0(double x)
 {
-    for (int i = 0 ; i < m_window_size_samples ; i++ )
+    double sum = 1.0;
+    double term = 1.0;
+    double half_x = x / 2.0;
+    for (int k = 1 ; k < 50 ; k++)
     {
-        sample_buffer[i] = applyWindowToNumberedSample(sample_buffer[i], i);
+        term *= (half_x / k) * (half_x / k);
+        sum += term;
+        if (term < sum * 1e-17)
+        {
+            break;
+        }
     }
+    return sum;
 }
-
-void Windowing::resetIndex()
-{
-    m_sample_number = 0;
-}
\ No newline at end of file
@@ -12,16 +12,23 @@ Date: 24/12/2023
 #include <math.h>
 #include <limits>
 
-#define sample_t float
+/*
+Default sample type. Core processors are templated on sample type (e.g. BasicBiquad<double>, BasicOnepole<Q15>), and their
+original names (Biquad, Onepole, GoertzelAlgorithm...) are aliases for sample_t, so existing code is unchanged.
+*/
+typedef float sample_t;
 
-sample_t dBToLin(sample_t db_value)
+inline sample_t dBToLin(sample_t db_value)
 {
     return pow(10, db_value / 20.0);
 }
 
-sample_t linTodB(sample_t db_value)
+/*
+Return: 20 * log10(lin_value), or -infinity for 0. See au_FastMath.h for faster approximations of this and dBToLin().
+*/
+inline sample_t linTodB(sample_t lin_value)
 {
-    return 0;
+    return 20.0 * log10(fabs(lin_value));
 }
 
 template <typename T>
@@ -38,7 +45,7 @@ constexpr T normalisedToInt(sample_t normalised_value) {
     :  static_cast<sample_t>(normalised_value) * std::numeric_limits<T>::max();
 }
 
-sample_t auClamp(sample_t value, sample_t lower, sample_t upper)
+inline sample_t auClamp(sample_t value, sample_t lower, sample_t upper)
 {
     if (value > upper)
     {
@@ -0,0 +1,68 @@
+/*
+
+test_CircularBuffer.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Regression checks for CircularBuffer's block API after single element overruns and underruns.
+Build and run from this directory: g++ -std=c++14 -I.. test_CircularBuffer.cpp -o test_CircularBuffer && ./test_CircularBuffer
+
+*/
+
+#include "au_CircularBuffer.h"
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+int main()
+{
+    //Underrun with single reads, then a block write: must not be given more space than the buffer holds
+    {
+        CircularBuffer<float, 8> buffer;
+        for (int i = 0 ; i < 10 ; i++)
+        {
+            buffer.read();
+        }
+        float values[18] = {};
+        size_t written = buffer.write(values, 18);
+        check(written <= 8, "block write after underrun is limited to the buffer length");
+        CircularBuffer<float, 8>::Spans spans = buffer.prepareWrite(18);
+        check(spans.size() <= 8, "prepareWrite after underrun is limited to the buffer length");
+    }
+
+    //Overrun with single writes, then a block read: must not return more values than the buffer holds
+    {
+        CircularBuffer<float, 8> buffer;
+        for (int i = 0 ; i < 12 ; i++)
+        {
+            buffer.write(static_cast<float>(i));
+        }
+        float values[12] = {};
+        size_t read = buffer.read(values, 12);
+        check(read <= 8, "block read after overrun is limited to the buffer length");
+    }
+
+    //Non power of two length takes the modulo path
+    {
+        CircularBuffer<int, 5> buffer;
+        int in[4] = {1, 2, 3, 4};
+        int out[4] = {};
+        buffer.write(in, 3);
+        buffer.read(out, 3);
+        check(buffer.write(in, 4) == 4, "wrapping block write");
+        check(buffer.read(out, 4) == 4 && out[0] == 1 && out[3] == 4, "wrapping block read");
+    }
+
+    printf(failures == 0 ? "test_CircularBuffer: passed\n" : "test_CircularBuffer: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/*
+
+test_Denormals.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Checks that Biquad, Onepole and KarplusStrong never reach denormals when their input goes silent after a signal, with either
+per block flushDenormals() or ScopedFlushToZero (see au_Denormals.h):
+- no output sample is ever denormal
+- the tail has decayed to exactly zero (so no state is left to decay into the denormal range)
+The cost per sample of steady state and of the silent tail, with and without protection, is printed for comparison. It isn't
+checked, as timings vary too much on loaded or virtualised machines.
+Build and run from this directory: g++ -std=c++14 -O2 -I.. test_Denormals.cpp -o test_Denormals && ./test_Denormals
+
+*/
+
+#include "au_Biquad.h"
+#include "au_Onepole.h"
+#include "au_KarplusStrong.h"
+#include "au_Denormals.h"
+#include <chrono>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+static const size_t BLOCK_SIZE = 64;
+
+static int failures = 0;
+
+enum class Protection
+{
+    NONE,
+    FLUSH,
+    FTZ
+};
+
+static const char* protectionName(Protection protection)
+{
+    switch (protection)
+    {
+    case Protection::FLUSH:
+        return "flushDenormals()";
+    case Protection::FTZ:
+        return "ScopedFlushToZero";
+    default:
+        return "none";
+    }
+}
+
+static bool isDenormal(sample_t value)
+{
+    return value != 0 && fabsf(value) < FLT_MIN;
+}
+
+/*
+Run a processor for num_blocks blocks with the given protection, returning the cost in ns per sample.
+
+Parameters:
+process_block - renders one block of BLOCK_SIZE samples into its argument (silent or not)
+flush - the processor's flushDenormals()
+denormal_outputs - incremented for every denormal output sample
+nonzero_outputs - set to the number of nonzero output samples in the last block
+*/
+template<typename ProcessBlock, typename Flush>
+static double timeBlocks(Protection protection, int num_blocks, ProcessBlock process_block, Flush flush, long& denormal_outputs,
+                         int& nonzero_outputs)
+{
+    sample_t output[BLOCK_SIZE];
+    auto start = std::chrono::steady_clock::now();
+    for (int block = 0 ; block < num_blocks ; block++)
+    {
+        if (protection == Protection::FTZ)
+        {
+            ScopedFlushToZero flush_to_zero;
+            process_block(output);
+        }
+        else
+        {
+            process_block(output);
+            if (protection == Protection::FLUSH)
+            {
+                flush();
+            }
+        }
+        nonzero_outputs = 0;
+        for (size_t n = 0 ; n < BLOCK_SIZE ; n++)
+        {
+            denormal_outputs += isDenormal(output[n]) ? 1 : 0;
+            nonzero_outputs += output[n] != 0 ? 1 : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(num_blocks) * BLOCK_SIZE);
+}
+
+/*
+Time steady state (signal) against the silent tail that follows it.
+
+Parameters:
+silent_blocks - long enough for the state to decay well into the denormal range without protection
+*/
+template<typename Setup, typename ProcessSignal, typename ProcessSilence, typename Flush>
+static void testTail(const char* name, int silent_blocks, Setup setup, ProcessSignal process_signal, ProcessSilence process_silence,
+                     Flush flush)
+{
+    const Protection protections[] = {Protection::NONE, Protection::FLUSH, Protection::FTZ};
+    for (Protection protection : protections)
+    {
+        setup();
+        long denormal_outputs = 0;
+        int nonzero_outputs = 0;
+        double steady_ns = timeBlocks(protection, 2000, process_signal, flush, denormal_outputs, nonzero_outputs);
+        timeBlocks(protection, silent_blocks, process_silence, flush, denormal_outputs, nonzero_outputs);
+        double tail_ns = timeBlocks(protection, 2000, process_silence, flush, denormal_outputs, nonzero_outputs);
+
+        bool checked = protection == Protection::FLUSH || (protection == Protection::FTZ && ScopedFlushToZero::IS_SUPPORTED);
+        bool passed = !checked || (denormal_outputs == 0 && nonzero_outputs == 0);
+        printf("%-14s %-18s steady %6.2f ns/sample, tail %7.2f ns/sample, denormal outputs %ld, nonzero tail outputs %d %s\n",
+               name, protectionName(protection), steady_ns, tail_ns, denormal_outputs, nonzero_outputs, passed ? "" : "FAIL");
+        if (!passed)
+        {
+            failures++;
+        }
+    }
+}
+
+int main()
+{
+    if (!ScopedFlushToZero::IS_SUPPORTED)
+    {
+        printf("ScopedFlushToZero not supported on this target, FTZ results are unprotected and not checked\n");
+    }
+
+    sample_t signal[BLOCK_SIZE];
+    for (size_t n = 0 ; n < BLOCK_SIZE ; n++)
+    {
+        signal[n] = 0.5f * sinf(0.3f * n);
+    }
+    const sample_t silence[BLOCK_SIZE] = {};
+
+    Biquad biquad;
+    testTail("Biquad", 3000,
+             [&]() { biquad.setup({48000.0f, 1000.0f, 10.0f, 0.0f, Biquad::FilterType::LOWPASS}); biquad.clean(); },
+             [&](sample_t* output) { biquad.processBlock(signal, output, BLOCK_SIZE); },
+             [&](sample_t* output) { biquad.processBlock(silence, output, BLOCK_SIZE); },
+             [&]() { biquad.flushDenormals(); });
+
+    Onepole onepole;
+    testTail("Onepole", 200000,
+             [&]() { onepole = Onepole(-0.999f); },
+             [&](sample_t* output) { for (size_t n = 0 ; n < BLOCK_SIZE ; n++) output[n] = onepole.process(signal[n]); },
+             [&](sample_t* output) { for (size_t n = 0 ; n < BLOCK_SIZE ; n++) output[n] = onepole.process(0.0f); },
+             [&]() { onepole.flushDenormals(); });
+
+    AudioUtils::KarplusStrong string(48000);
+    testTail("KarplusStrong", 20000,
+             [&]() { string.setFrequency(220.0f); string.setDamping(0.9f); string.pluck(); },
+             [&](sample_t* output) { string.processBlock(signal, output, BLOCK_SIZE); },
+             [&](sample_t* output) { string.processBlock(nullptr, output, BLOCK_SIZE); },
+             [&]() { string.flushDenormals(); });
+
+    //Flushing after a whole number of delay lines (48000 / 20Hz + 2 = 2402 samples each) must still cover the line, as the
+    //write point is back where the last flush left it
+    {
+        const size_t sparse_block_size = 2 * 2402;
+        AudioUtils::KarplusStrong sparse_string(48000);
+        sparse_string.setFrequency(220.0f);
+        sparse_string.setDamping(0.9f);
+        sparse_string.pluck();
+        static sample_t output[sparse_block_size];
+        long denormal_outputs = 0;
+        for (int block = 0 ; block < 400 ; block++)
+        {
+            sparse_string.processBlock(nullptr, output, sparse_block_size);
+            sparse_string.flushDenormals();
+            for (size_t n = 0 ; n < sparse_block_size ; n++)
+            {
+                denormal_outputs += isDenormal(output[n]) ? 1 : 0;
+            }
+        }
+        bool passed = denormal_outputs == 0;
+        printf("KarplusStrong  flush every 4804     denormal outputs %ld %s\n", denormal_outputs, passed ? "" : "FAIL");
+        failures += passed ? 0 : 1;
+    }
+
+    printf(failures == 0 ? "test_Denormals: passed\n" : "test_Denormals: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
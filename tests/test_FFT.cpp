@@ -0,0 +1,114 @@
+/*
+
+test_FFT.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Accuracy of FFT against a double precision direct DFT, and of the inverse(forward(x)) round trip, for N = 4 to 8192 with white
+noise input. Errors are the largest error over all bins (or samples) relative to the largest bin magnitude (or sample).
+Build and run from this directory: g++ -std=c++14 -O2 -I.. test_FFT.cpp -o test_FFT && ./test_FFT
+
+*/
+
+#include "au_FFT.h"
+#include "au_Noise.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static const double MAX_FORWARD_ERROR = 2.5e-7;
+static const double MAX_ROUND_TRIP_ERROR = 1e-6;
+
+static int failures = 0;
+
+static void check(const char* name, int fft_size, double measured, double limit)
+{
+    bool passed = measured <= limit;
+    printf("%-10s N = %-5d %.3g (limit %.3g) %s\n", name, fft_size, measured, limit, passed ? "" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+static void testSize(int fft_size)
+{
+    FFT fft;
+    if (!fft.setup(fft_size))
+    {
+        printf("FAIL: setup(%d)\n", fft_size);
+        failures++;
+        return;
+    }
+
+    NoiseGenerator noise(static_cast<uint32_t>(fft_size));
+    std::vector<sample_t> input(fft_size);
+    noise.white(input.data(), fft_size);
+
+    //Direct DFT, with the twiddle index reduced mod N so every angle is exact to double precision
+    std::vector<double> cos_table(fft_size);
+    std::vector<double> sin_table(fft_size);
+    for (int n = 0 ; n < fft_size ; n++)
+    {
+        cos_table[n] = cos(2.0 * M_PI * n / fft_size);
+        sin_table[n] = sin(2.0 * M_PI * n / fft_size);
+    }
+    std::vector<double> dft_real(fft_size / 2 + 1);
+    std::vector<double> dft_imaginary(fft_size / 2 + 1);
+    double largest_magnitude = 0;
+    for (int k = 0 ; k <= fft_size / 2 ; k++)
+    {
+        double real = 0;
+        double imaginary = 0;
+        for (int n = 0 ; n < fft_size ; n++)
+        {
+            int index = static_cast<int>((static_cast<long>(k) * n) % fft_size);
+            real += input[n] * cos_table[index];
+            imaginary -= input[n] * sin_table[index];
+        }
+        dft_real[k] = real;
+        dft_imaginary[k] = imaginary;
+        largest_magnitude = fmax(largest_magnitude, sqrt((real * real) + (imaginary * imaginary)));
+    }
+
+    std::vector<sample_t> buffer(input);
+    fft.forward(buffer.data());
+    double forward_error = fmax(fabs(buffer[0] - dft_real[0]), fabs(buffer[1] - dft_real[fft_size / 2]));
+    for (int k = 1 ; k < fft_size / 2 ; k++)
+    {
+        double real_error = buffer[2 * k] - dft_real[k];
+        double imaginary_error = buffer[2 * k + 1] - dft_imaginary[k];
+        forward_error = fmax(forward_error, sqrt((real_error * real_error) + (imaginary_error * imaginary_error)));
+    }
+    check("forward", fft_size, forward_error / largest_magnitude, MAX_FORWARD_ERROR);
+
+    fft.inverse(buffer.data());
+    double round_trip_error = 0;
+    double largest_sample = 0;
+    for (int n = 0 ; n < fft_size ; n++)
+    {
+        round_trip_error = fmax(round_trip_error, fabs(buffer[n] - input[n]));
+        largest_sample = fmax(largest_sample, fabs(input[n]));
+    }
+    check("round trip", fft_size, round_trip_error / largest_sample, MAX_ROUND_TRIP_ERROR);
+}
+
+int main()
+{
+    for (int fft_size = 4 ; fft_size <= 8192 ; fft_size *= 2)
+    {
+        testSize(fft_size);
+    }
+
+    FFT fft;
+    bool rejected = !fft.setup(0) && !fft.setup(2) && !fft.setup(6) && !fft.setup(1000);
+    if (!rejected)
+    {
+        printf("FAIL: unsupported sizes rejected\n");
+        failures++;
+    }
+
+    printf(failures == 0 ? "test_FFT: passed\n" : "test_FFT: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/*
+
+test_FastMath.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Accuracy of FastMath against double precision libm. Sweeps each function densely over the range given in the error table in
+au_FastMath.h, prints the maximum error found, and fails if it exceeds the table by more than LIMIT_MARGIN. The table gives
+measured maxima, so the margin leaves room for other compilers, libm versions and FMA contraction.
+Build and run from this directory: g++ -std=c++14 -O2 -I.. test_FastMath.cpp -o test_FastMath && ./test_FastMath
+
+*/
+
+#include "au_FastMath.h"
+#include <math.h>
+#include <stdio.h>
+
+typedef FastMath::Accuracy Accuracy;
+
+static const double LIMIT_MARGIN = 1.1;
+
+static int failures = 0;
+
+static void check(const char* name, const char* accuracy_name, double measured, double limit, const char* units)
+{
+    bool passed = measured <= limit * LIMIT_MARGIN;
+    printf("%-8s %-7s %.3g %s (table %.3g) %s\n", name, accuracy_name, measured, units, limit, passed ? "" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+/*
+Error limits, as in the table in au_FastMath.h.
+*/
+struct Limits
+{
+    const char* name;
+    double exp2_rel;
+    double log2_abs;
+    double db_to_lin_rel;
+    double lin_to_db_db;
+    double sin_cos_abs;
+    double tan_rel;
+    double tanh_abs;
+};
+
+template<Accuracy accuracy>
+static void testAccuracy(const Limits& limits)
+{
+    //Errors are measured against the float input, as FastMath only sees the float
+    double exp2_error = 0;
+    for (double x = -126.0 ; x <= 127.0 ; x += 1.3e-5)
+    {
+        float x_float = static_cast<float>(x);
+        double reference = exp2(static_cast<double>(x_float));
+        exp2_error = fmax(exp2_error, fabs(FastMath::exp2<accuracy>(x_float) - reference) / reference);
+    }
+    check("exp2", limits.name, exp2_error, limits.exp2_rel, "rel");
+
+    //Every float from 0.5 to 2
+    double log2_error = 0;
+    for (float x = 0.5f ; x <= 2.0f ; x = nextafterf(x, 3.0f))
+    {
+        log2_error = fmax(log2_error, fabs(FastMath::log2<accuracy>(x) - log2(static_cast<double>(x))));
+    }
+    check("log2", limits.name, log2_error, limits.log2_abs, "abs");
+
+    double db_to_lin_error = 0;
+    for (double db = -700.0 ; db <= 700.0 ; db += 7.3e-5)
+    {
+        float db_float = static_cast<float>(db);
+        double reference = pow(10.0, db_float / 20.0);
+        db_to_lin_error = fmax(db_to_lin_error, fabs(FastMath::dBToLin<accuracy>(db_float) - reference) / reference);
+    }
+    check("dBToLin", limits.name, db_to_lin_error, limits.db_to_lin_rel, "rel");
+
+    //Geometric sweep, 1e-6 to 1e3
+    double lin_to_db_error = 0;
+    for (double x = 1e-6 ; x <= 1e3 ; x *= 1.0000007)
+    {
+        float x_float = static_cast<float>(x);
+        double reference = 20.0 * log10(static_cast<double>(x_float));
+        lin_to_db_error = fmax(lin_to_db_error, fabs(FastMath::linTodB<accuracy>(x_float) - reference));
+    }
+    check("linTodB", limits.name, lin_to_db_error, limits.lin_to_db_db, "dB");
+
+    double sin_cos_error = 0;
+    for (double x = -M_PI ; x <= M_PI ; x += 3e-7)
+    {
+        float x_float = static_cast<float>(x);
+        sin_cos_error = fmax(sin_cos_error, fabs(FastMath::sin<accuracy>(x_float) - sin(static_cast<double>(x_float))));
+        sin_cos_error = fmax(sin_cos_error, fabs(FastMath::cos<accuracy>(x_float) - cos(static_cast<double>(x_float))));
+    }
+    check("sin/cos", limits.name, sin_cos_error, limits.sin_cos_abs, "abs");
+
+    double tan_error = 0;
+    for (double x = -1.5 ; x <= 1.5 ; x += 3e-7)
+    {
+        float x_float = static_cast<float>(x);
+        double reference = tan(static_cast<double>(x_float));
+        if (reference != 0)
+        {
+            tan_error = fmax(tan_error, fabs(FastMath::tan<accuracy>(x_float) - reference) / fabs(reference));
+        }
+    }
+    check("tan", limits.name, tan_error, limits.tan_rel, "rel");
+
+    double tanh_error = 0;
+    for (double x = -20.0 ; x <= 20.0 ; x += 3e-6)
+    {
+        float x_float = static_cast<float>(x);
+        tanh_error = fmax(tanh_error, fabs(FastMath::tanh<accuracy>(x_float) - tanh(static_cast<double>(x_float))));
+    }
+    check("tanh", limits.name, tanh_error, limits.tanh_abs, "abs");
+}
+
+int main()
+{
+    testAccuracy<Accuracy::LOW>({"LOW", 7.5e-5, 5.7e-6, 7.8e-5, 4.5e-5, 1.1e-4, 2.2e-4, 2.4e-2});
+    testAccuracy<Accuracy::MEDIUM>({"MEDIUM", 2.7e-6, 1.5e-7, 5.6e-6, 1.2e-5, 1.2e-6, 3.0e-6, 1.4e-6});
+    testAccuracy<Accuracy::HIGH>({"HIGH", 1.1e-7, 1.2e-7, 3.0e-6, 1.2e-5, 3.6e-7, 3.0e-6, 1.4e-7});
+
+    printf(failures == 0 ? "test_FastMath: passed\n" : "test_FastMath: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+/*
+
+test_KarplusStrong.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Regression checks for KarplusStrong's delay buffer sizing: the default delay must fit a buffer sized for a low sample rate
+or a high lowest fundamental. Build with -fsanitize=address to also catch out of bounds access.
+Build and run from this directory: g++ -std=c++14 -I.. test_KarplusStrong.cpp -o test_KarplusStrong && ./test_KarplusStrong
+
+*/
+
+#include "au_KarplusStrong.h"
+#include <math.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+/*
+Pluck with the default frequency and play a second, checking the delay fits and the output stays finite.
+*/
+static void testDefaultDelay(int sample_rate, sample_t lowest_fundamental_hz, const char* description)
+{
+    AudioUtils::KarplusStrong string(sample_rate, lowest_fundamental_hz);
+    check(string.getFrequency() >= lowest_fundamental_hz && string.getFrequency() <= sample_rate / 2, description);
+    string.pluck();
+    sample_t output[64];
+    bool finite = true;
+    for (int block = 0 ; block < sample_rate / 64 ; block++)
+    {
+        string.processBlock(nullptr, output, 64);
+        for (int i = 0 ; i < 64 ; i++)
+        {
+            finite = finite && isfinite(output[i]);
+        }
+    }
+    check(finite, description);
+}
+
+int main()
+{
+    testDefaultDelay(48000, 500.0f, "default delay fits with a high lowest fundamental");
+    testDefaultDelay(8000, 20.0f, "default delay fits at a low sample rate");
+    testDefaultDelay(8000, 1000.0f, "default delay fits at a low sample rate and high lowest fundamental");
+    testDefaultDelay(192000, 20.0f, "default delay at a high sample rate");
+
+    printf(failures == 0 ? "test_KarplusStrong: passed\n" : "test_KarplusStrong: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
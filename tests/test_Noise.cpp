@@ -0,0 +1,127 @@
+/*
+
+test_Noise.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Checks NoiseGenerator streams for different seeds are unrelated (not shifted copies of each other, and uncorrelated), and that
+the block fills give the same values as the per sample calls.
+Build and run from this directory: g++ -std=c++14 -I.. test_Noise.cpp -o test_Noise && ./test_Noise
+
+*/
+
+#include "au_Noise.h"
+#include <math.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+static const int STREAM_LENGTH = 100000;
+static const int MAX_SHIFT = 64;
+
+/*
+Return: the most values of stream b found at the same place in stream a shifted by -MAX_SHIFT to +MAX_SHIFT.
+*/
+static int mostShiftedMatches(const uint32_t* a, const uint32_t* b)
+{
+    int most_matches = 0;
+    for (int shift = -MAX_SHIFT ; shift <= MAX_SHIFT ; shift++)
+    {
+        int matches = 0;
+        for (int n = MAX_SHIFT ; n < STREAM_LENGTH - MAX_SHIFT ; n++)
+        {
+            matches += a[n + shift] == b[n] ? 1 : 0;
+        }
+        most_matches = matches > most_matches ? matches : most_matches;
+    }
+    return most_matches;
+}
+
+static double correlation(const sample_t* a, const sample_t* b)
+{
+    double ab = 0;
+    double aa = 0;
+    double bb = 0;
+    for (int n = 0 ; n < STREAM_LENGTH ; n++)
+    {
+        ab += static_cast<double>(a[n]) * b[n];
+        aa += static_cast<double>(a[n]) * a[n];
+        bb += static_cast<double>(b[n]) * b[n];
+    }
+    return ab / sqrt(aa * bb);
+}
+
+int main()
+{
+    static uint32_t a[STREAM_LENGTH];
+    static uint32_t b[STREAM_LENGTH];
+
+    //Seeds whose multiplied values differ by 1 (340573321 is the inverse of 0x9E3779B9 mod 2^32), which gave the same stream
+    //shifted by one sample when the seed was added to the counter
+    const uint32_t seed_pairs[][2] = {{1, 340573322}, {1, 2}, {0, 1}, {123456, 123457}, {7, 0x80000007u}};
+    for (const auto& seeds : seed_pairs)
+    {
+        NoiseGenerator generator_a(seeds[0]);
+        NoiseGenerator generator_b(seeds[1]);
+        for (int n = 0 ; n < STREAM_LENGTH ; n++)
+        {
+            a[n] = generator_a.nextUint();
+            b[n] = generator_b.nextUint();
+        }
+        int matches = mostShiftedMatches(a, b);
+        printf("seeds %u, %u: most matches at any shift %d\n", seeds[0], seeds[1], matches);
+        check(matches <= 2, "different seeds don't give shifted copies of one stream");
+    }
+
+    //Correlation of white noise between generators with neighbouring seeds, 5 standard deviations is about 0.016
+    static sample_t white_a[STREAM_LENGTH];
+    static sample_t white_b[STREAM_LENGTH];
+    double largest_correlation = 0;
+    for (uint32_t seed = 1 ; seed < 16 ; seed++)
+    {
+        NoiseGenerator generator_a(seed);
+        NoiseGenerator generator_b(seed + 1);
+        generator_a.white(white_a, STREAM_LENGTH);
+        generator_b.white(white_b, STREAM_LENGTH);
+        largest_correlation = fmax(largest_correlation, fabs(correlation(white_a, white_b)));
+    }
+    printf("largest correlation between neighbouring seeds %.4f\n", largest_correlation);
+    check(largest_correlation < 0.016, "neighbouring seeds give uncorrelated white noise");
+
+    //Block fills match per sample calls, including across block boundaries
+    {
+        NoiseGenerator per_sample(42);
+        NoiseGenerator block(42);
+        sample_t block_values[100];
+        bool white_same = true;
+        bool tpdf_same = true;
+        for (int repeat = 0 ; repeat < 10 ; repeat++)
+        {
+            block.white(block_values, 37);
+            for (int n = 0 ; n < 37 ; n++)
+            {
+                white_same = white_same && block_values[n] == per_sample.white();
+            }
+            block.tpdf(block_values, 23, 0.5f);
+            for (int n = 0 ; n < 23 ; n++)
+            {
+                tpdf_same = tpdf_same && block_values[n] == per_sample.tpdf(0.5f);
+            }
+        }
+        check(white_same, "white() block fill matches per sample white()");
+        check(tpdf_same, "tpdf() block fill matches per sample tpdf()");
+    }
+
+    printf(failures == 0 ? "test_Noise: passed\n" : "test_Noise: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
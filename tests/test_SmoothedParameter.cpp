@@ -0,0 +1,96 @@
+/*
+
+test_SmoothedParameter.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Regression checks for SmoothedParameter: empty blocks during a ramp, and ramp time changes during a ramp.
+Build and run from this directory: g++ -std=c++14 -I.. test_SmoothedParameter.cpp -o test_SmoothedParameter && ./test_SmoothedParameter
+
+*/
+
+#include "au_SmoothedParameter.h"
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+int main()
+{
+    //An empty block mid ramp must not touch the buffer or move the value
+    {
+        SmoothedParameter linear;
+        linear.setup({48000.0f, 0.01f, SmoothedParameter::RampType::LINEAR, 0.0f});
+        linear.setTarget(1.0f);
+        sample_t ramp[64];
+        linear.processBlock(ramp, 10);
+        sample_t before = linear.getCurrentValue();
+        check(linear.processBlock(ramp, 0) == nullptr, "empty LINEAR block returns nullptr");
+        check(linear.getCurrentValue() == before, "empty LINEAR block leaves the value unchanged");
+
+        SmoothedParameter one_pole;
+        one_pole.setup({48000.0f, 0.01f, SmoothedParameter::RampType::ONE_POLE, 0.0f});
+        one_pole.setTarget(1.0f);
+        check(one_pole.processBlock(ramp, 0) == nullptr, "empty ONE_POLE block returns nullptr");
+    }
+
+    //setRampTime() mid ramp leaves the ramp in progress unchanged, and applies from the next setTarget()
+    {
+        SmoothedParameter reference;
+        SmoothedParameter changed;
+        reference.setup({48000.0f, 0.01f, SmoothedParameter::RampType::ONE_POLE, 0.0f});
+        changed.setup({48000.0f, 0.01f, SmoothedParameter::RampType::ONE_POLE, 0.0f});
+        reference.setTarget(1.0f);
+        changed.setTarget(1.0f);
+        sample_t reference_ramp[64];
+        sample_t changed_ramp[64];
+        reference.processBlock(reference_ramp, 64);
+        changed.processBlock(changed_ramp, 64);
+        changed.setRampTime(0.0001f);
+
+        bool same = true;
+        while (reference.isSmoothing() || changed.isSmoothing())
+        {
+            const sample_t* reference_out = reference.processBlock(reference_ramp, 64);
+            const sample_t* changed_out = changed.processBlock(changed_ramp, 64);
+            same = same && ((reference_out == nullptr) == (changed_out == nullptr));
+            for (int i = 0 ; same && reference_out != nullptr && i < 64 ; i++)
+            {
+                same = reference_ramp[i] == changed_ramp[i];
+            }
+            if (!same)
+            {
+                break;
+            }
+        }
+        check(same, "ONE_POLE ramp in progress is unchanged by setRampTime()");
+
+        reference.setTarget(0.0f);
+        changed.setTarget(0.0f);
+        size_t reference_length = 0;
+        size_t changed_length = 0;
+        while (reference.isSmoothing())
+        {
+            reference.getNextValue();
+            reference_length++;
+        }
+        while (changed.isSmoothing())
+        {
+            changed.getNextValue();
+            changed_length++;
+        }
+        check(changed_length < reference_length, "new ramp time applies from the next setTarget()");
+    }
+
+    printf(failures == 0 ? "test_SmoothedParameter: passed\n" : "test_SmoothedParameter: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/*
+
+test_SpscCircularBuffer.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Checks SpscCircularBuffer keeps values in order, and full/empty correct, as the read and write positions wrap many times, for
+power of two and non power of two lengths, single threaded and with a producer and consumer thread.
+Build and run from this directory: g++ -std=c++14 -pthread -I.. test_SpscCircularBuffer.cpp -o test_SpscCircularBuffer && ./test_SpscCircularBuffer
+
+*/
+
+#include "au_SpscCircularBuffer.h"
+#include <stdio.h>
+#include <thread>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+template<unsigned long buffer_length>
+static void testSingleThread(const char* description)
+{
+    SpscCircularBuffer<int, buffer_length> buffer;
+    int next_write = 0;
+    int next_read = 0;
+    bool in_order = true;
+    bool counts_correct = true;
+    int values[buffer_length + 3];
+    for (int round = 0 ; round < 100000 ; round++)
+    {
+        //Mixed single and block operations, with block sizes that don't divide the length
+        size_t num_to_write = 1 + (round * 7) % (buffer_length + 2);
+        for (size_t i = 0 ; i < num_to_write ; i++)
+        {
+            values[i] = next_write + static_cast<int>(i);
+        }
+        size_t space = buffer_length - static_cast<size_t>(buffer.itemsInBuffer());
+        size_t written = (round % 3 == 0) ? (buffer.write(values[0]) ? 1 : 0) : buffer.write(values, num_to_write);
+        counts_correct = counts_correct && written == (round % 3 == 0 ? (space > 0 ? 1 : 0) : (num_to_write < space ? num_to_write : space));
+        next_write += static_cast<int>(written);
+
+        size_t num_to_read = 1 + (round * 5) % (buffer_length + 1);
+        size_t read = (round % 4 == 0) ? (buffer.read(values[0]) ? 1 : 0) : buffer.read(values, num_to_read);
+        for (size_t i = 0 ; i < read ; i++)
+        {
+            in_order = in_order && values[i] == next_read;
+            next_read++;
+        }
+        counts_correct = counts_correct && buffer.itemsInBuffer() == next_write - next_read;
+        counts_correct = counts_correct && buffer.itemsInBuffer() <= static_cast<long>(buffer_length);
+    }
+    check(in_order, description);
+    check(counts_correct, description);
+}
+
+template<unsigned long buffer_length>
+static void testTwoThreads(const char* description)
+{
+    const int num_values = 1000000;
+    SpscCircularBuffer<int, buffer_length> buffer;
+    std::thread producer([&]()
+    {
+        int values[7];
+        int next_write = 0;
+        while (next_write < num_values)
+        {
+            int num_to_write = num_values - next_write < 7 ? num_values - next_write : 7;
+            for (int i = 0 ; i < num_to_write ; i++)
+            {
+                values[i] = next_write + i;
+            }
+            size_t written = buffer.write(values, static_cast<size_t>(num_to_write));
+            if (written == 0)
+            {
+                std::this_thread::yield();
+            }
+            next_write += static_cast<int>(written);
+        }
+    });
+
+    bool in_order = true;
+    int values[5];
+    int next_read = 0;
+    while (next_read < num_values)
+    {
+        size_t read = buffer.read(values, 5);
+        if (read == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0 ; i < read ; i++)
+        {
+            in_order = in_order && values[i] == next_read;
+            next_read++;
+        }
+    }
+    producer.join();
+    check(in_order, description);
+}
+
+int main()
+{
+    testSingleThread<5>("single thread, length 5");
+    testSingleThread<8>("single thread, length 8");
+    testSingleThread<1>("single thread, length 1");
+    testTwoThreads<12>("two threads, length 12");
+    testTwoThreads<16>("two threads, length 16");
+
+    printf(failures == 0 ? "test_SpscCircularBuffer: passed\n" : "test_SpscCircularBuffer: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/*
+
+test_Windowing.cpp
+
+Author: Matt Davison
+Date: 17/10/2026
+
+Checks Windowing tables are 64 byte aligned for any window size and hold the expected coefficients. Builds as C++11.
+Build and run from this directory: g++ -std=c++11 -I.. test_Windowing.cpp -o test_Windowing && ./test_Windowing
+
+*/
+
+#include "au_Windowing.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", description);
+        failures++;
+    }
+}
+
+int main()
+{
+    bool aligned = true;
+    for (int window_size = 1 ; window_size < 300 ; window_size++)
+    {
+        Windowing window(Windowing::WindowType::BLACKMAN_HARRIS, window_size);
+        aligned = aligned && (reinterpret_cast<uintptr_t>(window.getWindowTable()) % 64) == 0;
+    }
+    check(aligned, "window tables are 64 byte aligned");
+
+    Windowing hann(Windowing::WindowType::HANN, 8);
+    const sample_t* table = hann.getWindowTable();
+    check(table[0] == 0.0f && table[4] == 1.0f && fabsf(table[2] - 0.5f) < 1e-6f, "Hann coefficients");
+
+    //Same configuration shares one table, a different size doesn't
+    Windowing shared(Windowing::WindowType::HANN, 8);
+    Windowing resized(Windowing::WindowType::HANN, 8);
+    resized.setWindowSizeSamples(16);
+    check(shared.getWindowTable() == table, "same configuration shares a table");
+    check(resized.getWindowTable() != table && resized.getWindowTable()[8] == 1.0f, "resized window has its own table");
+
+    printf(failures == 0 ? "test_Windowing: passed\n" : "test_Windowing: %d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}